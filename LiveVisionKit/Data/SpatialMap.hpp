@@ -21,6 +21,8 @@
 
 #include <opencv2/opencv.hpp>
 #include <optional>
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <tuple>
 
@@ -170,16 +172,34 @@ namespace lvk
 
         size_t fetch_data_link(const SpatialKey& key) const;
 
-        bool is_data_link_empty(const size_t link) const;
+        bool is_occupied(const size_t index) const;
 
-        void clear_data_link(size_t& link);
+        void set_occupied(const size_t index);
+
+        void reset_occupied(const size_t index);
+
+        void occupy_all();
+
+        void track_item(const SpatialKey& key);
+
+        void untrack_item(const SpatialKey& key);
+
+        void reset_statistics();
 
     private:
-        constexpr static size_t m_EmptySymbol = std::numeric_limits<size_t>::max();
+        constexpr static int m_DistributionSectors = 4;
 
+        // Data links are only valid for occupied keys, so the
+        // occupancy bitset is all that needs to be kept cleared.
         VirtualGrid m_VirtualGrid;
         std::vector<size_t> m_Map;
+        std::vector<uint64_t> m_Occupancy;
         std::vector<std::pair<SpatialKey, T>> m_Data;
+
+        // Distribution statistics, kept up to date as items are placed and removed.
+        std::vector<uint8_t> m_ColSectors, m_RowSectors;
+        std::array<size_t, m_DistributionSectors * m_DistributionSectors> m_SectorCounts{};
+        cv::Point_<size_t> m_KeySum;
     };
 
     template<typename T>
@@ -30,6 +30,8 @@ namespace lvk
     // Max capacity to reserve in the data buffer when resizing the map.
     inline constexpr size_t MAX_DATA_RESERVE = 512;
 
+    inline constexpr size_t OCCUPANCY_WORD_BITS = 64;
+
 //---------------------------------------------------------------------------------------------------------------------
 
     template<typename T>
@@ -54,7 +56,12 @@ namespace lvk
     template<typename T>
     inline SpatialMap<T>::SpatialMap(const SpatialMap<T>&& other) noexcept
         : m_Map(std::move(other.m_Map)),
+          m_Occupancy(std::move(other.m_Occupancy)),
           m_Data(std::move(other.m_Data)),
+          m_ColSectors(std::move(other.m_ColSectors)),
+          m_RowSectors(std::move(other.m_RowSectors)),
+          m_SectorCounts(other.m_SectorCounts),
+          m_KeySum(other.m_KeySum),
           m_VirtualGrid(other.m_VirtualGrid)
     {}
 
@@ -63,7 +70,12 @@ namespace lvk
     template<typename T>
     inline SpatialMap<T>::SpatialMap(const SpatialMap<T>& other)
         : m_Map(other.m_Map),
+          m_Occupancy(other.m_Occupancy),
           m_Data(other.m_Data),
+          m_ColSectors(other.m_ColSectors),
+          m_RowSectors(other.m_RowSectors),
+          m_SectorCounts(other.m_SectorCounts),
+          m_KeySum(other.m_KeySum),
           m_VirtualGrid(other.m_VirtualGrid)
     {}
 
@@ -73,7 +85,12 @@ namespace lvk
     inline SpatialMap<T>& SpatialMap<T>::operator=(SpatialMap&& other) noexcept
     {
         m_Map = std::move(other.m_Map);
+        m_Occupancy = std::move(other.m_Occupancy);
         m_Data = std::move(other.m_Data);
+        m_ColSectors = std::move(other.m_ColSectors);
+        m_RowSectors = std::move(other.m_RowSectors);
+        m_SectorCounts = other.m_SectorCounts;
+        m_KeySum = other.m_KeySum;
         m_VirtualGrid = other.m_VirtualGrid;
 
         return *this;
@@ -85,7 +102,12 @@ namespace lvk
     inline SpatialMap<T>& SpatialMap<T>::operator=(const SpatialMap& other)
     {
         m_Map = other.m_Map;
+        m_Occupancy = other.m_Occupancy;
         m_Data = other.m_Data;
+        m_ColSectors = other.m_ColSectors;
+        m_RowSectors = other.m_RowSectors;
+        m_SectorCounts = other.m_SectorCounts;
+        m_KeySum = other.m_KeySum;
         m_VirtualGrid = other.m_VirtualGrid;
 
         return *this;
@@ -103,22 +125,45 @@ namespace lvk
         {
             m_VirtualGrid.resize(resolution);
 
-            m_Map.clear();
-            m_Map.resize(resolution.area(), m_EmptySymbol);
+            m_Map.assign(resolution.area(), 0);
+            m_Occupancy.assign((m_Map.size() + OCCUPANCY_WORD_BITS - 1) / OCCUPANCY_WORD_BITS, 0);
             m_Data.reserve(std::min(m_Map.size(), MAX_DATA_RESERVE));
 
+            // Look up the distribution sector of each column and row, so that
+            // items can be bucketed without any floating point on placement.
+            const VirtualGrid sector_grid(
+                cv::Size(m_DistributionSectors, m_DistributionSectors),
+                cv::Rect(0, 0, resolution.width, resolution.height)
+            );
+            m_ColSectors.resize(resolution.width);
+            for(int x = 0; x < resolution.width; x++)
+            {
+                const auto sector = sector_grid.key_of(cv::Point2f(static_cast<float>(x), 0.0f)).x;
+                m_ColSectors[x] = static_cast<uint8_t>(std::min<size_t>(sector, m_DistributionSectors - 1));
+            }
+            m_RowSectors.resize(resolution.height);
+            for(int y = 0; y < resolution.height; y++)
+            {
+                const auto sector = sector_grid.key_of(cv::Point2f(0.0f, static_cast<float>(y))).y;
+                m_RowSectors[y] = static_cast<uint8_t>(std::min<size_t>(sector, m_DistributionSectors - 1));
+            }
+            reset_statistics();
+
             // Re-map all the elements which still fit in the new resolution.
-            for(size_t i = 0; i < m_Data.size(); i++)
+            for(size_t i = 0; i < m_Data.size();)
             {
-                // If the key is no longer valid erase the item,
-                // otherwise set its data link in the new map.
+                // If the key is no longer valid erase the item, otherwise set its
+                // data link in the new map. Erasing swaps in an unvisited item.
                 const auto& key = m_Data[i].first;
                 if(!m_VirtualGrid.test_key(key))
-                {
                     fast_erase(m_Data, i);
-                    if(i > 0) i--;
+                else
+                {
+                    const size_t index = m_VirtualGrid.key_to_index(key);
+                    set_occupied(index);
+                    track_item(key);
+                    m_Map[index] = i++;
                 }
-                else fetch_data_link(key) = i;
             }
 
         }
@@ -222,15 +267,17 @@ namespace lvk
         // If the key is empty, generate a new pointer,
         // otherwise we just replace the existing item.
 
-        size_t& data_link = fetch_data_link(key);
-        if(is_data_link_empty(data_link))
+        const size_t index = m_VirtualGrid.key_to_index(key);
+        if(!is_occupied(index))
         {
-            data_link = m_Data.size();
+            set_occupied(index);
+            track_item(key);
+            m_Map[index] = m_Data.size();
             return m_Data.emplace_back(key, item).second;
         }
         else
         {
-            auto& stored_data = m_Data[data_link].second;
+            auto& stored_data = m_Data[m_Map[index]].second;
             stored_data = item;
             return stored_data;
         }
@@ -250,15 +297,17 @@ namespace lvk
         // TODO: this isn't much of an optimization compared to the
         // place function, maybe there is something more we can do?
 
-        size_t& data_link = fetch_data_link(key);
-        if(is_data_link_empty(data_link))
+        const size_t index = m_VirtualGrid.key_to_index(key);
+        if(!is_occupied(index))
         {
-            data_link = m_Data.size();
+            set_occupied(index);
+            track_item(key);
+            m_Map[index] = m_Data.size();
             return m_Data.emplace_back(key, T{args...}).second;
         }
         else
         {
-            auto& stored_data = m_Data[data_link].second;
+            auto& stored_data = m_Data[m_Map[index]].second;
             stored_data = T{args...};
             return stored_data;
         }
@@ -342,6 +391,8 @@ namespace lvk
                 value
             );
         }
+
+        occupy_all();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -373,6 +424,8 @@ namespace lvk
                 T{args...}
             );
         }
+
+        occupy_all();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -383,12 +436,13 @@ namespace lvk
         // Fill all empty slots with the given value
         for(size_t index = 0; index < m_Map.size(); index++)
         {
-            size_t& data_link = m_Map[index];
-            if(is_data_link_empty(data_link))
+            if(!is_occupied(index))
             {
                 const SpatialKey key = m_VirtualGrid.index_to_key(index);
 
-                data_link = m_Data.size();
+                set_occupied(index);
+                track_item(key);
+                m_Map[index] = m_Data.size();
                 m_Data.emplace_back(key, value);
             }
         }
@@ -403,12 +457,13 @@ namespace lvk
         // Emplace all empty slots using the given arguments
         for(size_t index = 0; index < m_Map.size(); index++)
         {
-            size_t& data_link = m_Map[index];
-            if(is_data_link_empty(data_link))
+            if(!is_occupied(index))
             {
                 const SpatialKey key = m_VirtualGrid.index_to_key(index);
 
-                data_link = m_Data.size();
+                set_occupied(index);
+                track_item(key);
+                m_Map[index] = m_Data.size();
                 m_Data.emplace_back(key, T{args...});
             }
         }
@@ -426,21 +481,20 @@ namespace lvk
         // pop it off without having to shuffle any items. The item which
         // used to be last will have its data pointer adjusted as necessary.
 
-        size_t& item_data_link = fetch_data_link(key);
+        const size_t index = m_VirtualGrid.key_to_index(key);
+        const size_t item_data_link = m_Map[index];
 
-        const auto& [replace_key, replace_item] = m_Data.back();
-        if(key != replace_key)
+        if(item_data_link != m_Data.size() - 1)
         {
             // Swap the replacement item to the new position
-            std::swap(m_Data[item_data_link], replace_item);
-
-            size_t& replace_data_link = fetch_data_link(key);
-            replace_data_link = item_data_link;
+            std::swap(m_Data[item_data_link], m_Data.back());
+            fetch_data_link(m_Data[item_data_link].first) = item_data_link;
         }
 
         // Remove the requested item
         m_Data.pop_back();
-        clear_data_link(item_data_link);
+        reset_occupied(index);
+        untrack_item(key);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -461,9 +515,17 @@ namespace lvk
     template<typename T>
     inline void SpatialMap<T>::clear()
     {
-        m_Data.clear();
+        // Sparse maps reset only the bits of their items, so that clearing is
+        // proportional to the number of items rather than the map capacity.
+        if(m_Data.size() < m_Occupancy.size())
+        {
+            for(const auto& [key, item] : m_Data)
+                reset_occupied(m_VirtualGrid.key_to_index(key));
+        }
+        else std::fill(m_Occupancy.begin(), m_Occupancy.end(), 0);
 
-        std::fill(m_Map.begin(), m_Map.end(), m_EmptySymbol);
+        m_Data.clear();
+        reset_statistics();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -493,8 +555,8 @@ namespace lvk
     {
         LVK_ASSERT(m_VirtualGrid.test_key(key));
 
-        const size_t data_link = fetch_data_link(key);
-        return is_data_link_empty(data_link) ? value : m_Data[data_link].second;
+        const size_t index = m_VirtualGrid.key_to_index(key);
+        return is_occupied(index) ? m_Data[m_Map[index]].second : value;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -504,8 +566,8 @@ namespace lvk
     {
         LVK_ASSERT(m_VirtualGrid.test_key(key));
 
-        const size_t data_link = fetch_data_link(key);
-        return is_data_link_empty(data_link) ? value : m_Data[data_link].second;
+        const size_t index = m_VirtualGrid.key_to_index(key);
+        return is_occupied(index) ? m_Data[m_Map[index]].second : value;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -562,7 +624,7 @@ namespace lvk
     {
         LVK_ASSERT(m_VirtualGrid.test_key(key));
 
-        return !is_data_link_empty(fetch_data_link(key));
+        return is_occupied(m_VirtualGrid.key_to_index(key));
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -574,13 +636,11 @@ namespace lvk
         if(m_Data.empty())
             return {};
 
-        cv::Point_<P> centroid;
-        for(const auto& [point, value] : m_Data)
-            centroid += cv::Point_<P>(point);
-
-        centroid /= static_cast<P>(m_Data.size());
-
-        return centroid;
+        const auto count = static_cast<double>(m_Data.size());
+        return cv::Point_<P>(
+            static_cast<P>(static_cast<double>(m_KeySum.x) / count),
+            static_cast<P>(static_cast<double>(m_KeySum.y) / count)
+        );
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -597,28 +657,18 @@ namespace lvk
         // its inverse. If the map resolution is less than or equal to 4x4, then this technique will
         // not be meaningful so we instead approximate it by taking the map load.
 
-        constexpr int sectors = 4;
-
-        if(cols() <= sectors || rows() <= sectors)
+        if(cols() <= m_DistributionSectors || rows() <= m_DistributionSectors)
             return static_cast<float>(m_Data.size()) / static_cast<float>(m_Map.size());
 
-        const VirtualGrid sector_grid(cv::Size(sectors,  sectors), cv::Rect(0, 0, cols(), rows()));
-        std::array<size_t, sectors * sectors> sector_buckets{};
-
+        // The sector counts are maintained as items are placed and removed.
         const auto ideal_distribution = static_cast<size_t>(
-            static_cast<float>(m_Data.size()) / static_cast<float>(sector_buckets.size())
+            static_cast<float>(m_Data.size()) / static_cast<float>(m_SectorCounts.size())
         );
 
         float excess = 0.0;
-        for(const auto& [key, data] : m_Data)
-        {
-            if(sector_grid.test_point(key))
-            {
-                const size_t index = sector_grid.key_to_index(sector_grid.key_of(key));
-                if(++sector_buckets[index] > ideal_distribution)
-                    excess += 1.0;
-            }
-        }
+        for(const size_t count : m_SectorCounts)
+            if(count > ideal_distribution)
+                excess += static_cast<float>(count - ideal_distribution);
 
         // The maximum excess occurs when all points are in the same sector
         return  1.0f - (excess / static_cast<float>(m_Data.size() - ideal_distribution));
@@ -691,17 +741,68 @@ namespace lvk
 //---------------------------------------------------------------------------------------------------------------------
 
     template<typename T>
-    inline void SpatialMap<T>::clear_data_link(size_t& link)
+    inline bool SpatialMap<T>::is_occupied(const size_t index) const
+    {
+        return (m_Occupancy[index / OCCUPANCY_WORD_BITS] >> (index % OCCUPANCY_WORD_BITS)) & 1;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline void SpatialMap<T>::set_occupied(const size_t index)
+    {
+        m_Occupancy[index / OCCUPANCY_WORD_BITS] |= uint64_t(1) << (index % OCCUPANCY_WORD_BITS);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline void SpatialMap<T>::reset_occupied(const size_t index)
+    {
+        m_Occupancy[index / OCCUPANCY_WORD_BITS] &= ~(uint64_t(1) << (index % OCCUPANCY_WORD_BITS));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline void SpatialMap<T>::occupy_all()
+    {
+        std::fill(m_Occupancy.begin(), m_Occupancy.end(), ~uint64_t(0));
+
+        // Keep the bits past the end of the map unset, so that counts stay exact.
+        if(const size_t tail_bits = m_Map.size() % OCCUPANCY_WORD_BITS; tail_bits != 0)
+            m_Occupancy.back() = (uint64_t(1) << tail_bits) - 1;
+
+        reset_statistics();
+        for(size_t index = 0; index < m_Map.size(); index++)
+            track_item(m_VirtualGrid.index_to_key(index));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline void SpatialMap<T>::track_item(const SpatialKey& key)
+    {
+        m_SectorCounts[m_RowSectors[key.y] * m_DistributionSectors + m_ColSectors[key.x]]++;
+        m_KeySum += key;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline void SpatialMap<T>::untrack_item(const SpatialKey& key)
     {
-        link = m_EmptySymbol;
+        m_SectorCounts[m_RowSectors[key.y] * m_DistributionSectors + m_ColSectors[key.x]]--;
+        m_KeySum -= key;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     template<typename T>
-    inline bool SpatialMap<T>::is_data_link_empty(const size_t link) const
+    inline void SpatialMap<T>::reset_statistics()
     {
-        return link == m_EmptySymbol;
+        m_SectorCounts.fill(0);
+        m_KeySum = {};
     }
 
 //---------------------------------------------------------------------------------------------------------------------
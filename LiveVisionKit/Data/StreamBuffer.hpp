@@ -17,8 +17,12 @@
 
 #pragma once
 
+#include <type_traits>
+#include <concepts>
+#include <utility>
 #include <vector>
 #include <ostream>
+#include <span>
 
 #include "Iterators.hpp"
 
@@ -107,6 +111,20 @@ namespace lvk
 		T convolve_at(const StreamBuffer<K>& kernel, const size_t index) const;
 
 
+        T sum() const requires std::is_arithmetic_v<T>;
+
+        // NOTE: integral types would truncate the mean, and every deviation from it.
+        T mean() const requires std::floating_point<T>;
+
+        T variance() const requires std::floating_point<T>;
+
+
+        // The elements from oldest to newest, as at most two contiguous spans.
+        std::pair<std::span<T>, std::span<T>> spans();
+
+        std::pair<std::span<const T>, std::span<const T>> spans() const;
+
+
         iterator begin();
 
         const_iterator begin() const;
@@ -124,6 +142,9 @@ namespace lvk
 	private:
 		void advance_window();
 
+        template<typename K>
+        auto dot(const StreamBuffer<K>& kernel, size_t buffer_offset, size_t kernel_offset, size_t count) const;
+
 		size_t m_Capacity, m_Size = 0;
 		std::vector<T> m_InternalBuffer;
 		size_t m_StartIndex = 0, m_EndIndex = 0;
@@ -17,11 +17,42 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+
 #include "Directives.hpp"
 
 namespace lvk
 {
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Arithmetic reductions are split across independent accumulators, which
+    // breaks the dependency between additions and lets compilers vectorise them.
+    inline constexpr size_t REDUCTION_LANES = 8;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename A, typename F>
+    inline A accumulate_lanes(const size_t count, const F& term)
+    {
+        std::array<A, REDUCTION_LANES> lanes{};
+
+        size_t i = 0;
+        for(; i + REDUCTION_LANES <= count; i += REDUCTION_LANES)
+            for(size_t l = 0; l < REDUCTION_LANES; l++)
+                lanes[l] += term(i + l);
+
+        A total(0);
+        for(const auto& lane : lanes)
+            total += lane;
+
+        for(; i < count; i++)
+            total += term(i);
+
+        return total;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
 	template<typename T>
@@ -411,13 +442,60 @@ namespace lvk
 		}
 
 		// Perform the convolution
-        T result = this->at(buffer_offset) * kernel.at(kernel_offset);
-		for(size_t i = 1; i < elems; i++)
-            result += this->at(i + buffer_offset) * kernel.at(i + kernel_offset);
+        if constexpr(std::is_arithmetic_v<T> && std::is_arithmetic_v<K>)
+            return static_cast<T>(dot(kernel, buffer_offset, kernel_offset, elems));
+        else
+        {
+            T result = this->at(buffer_offset) * kernel.at(kernel_offset);
+            for(size_t i = 1; i < elems; i++)
+                result += this->at(i + buffer_offset) * kernel.at(i + kernel_offset);
 
-		return result;
+            return result;
+        }
 	}
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    template<typename K>
+    inline auto StreamBuffer<T>::dot(
+        const StreamBuffer<K>& kernel,
+        size_t buffer_offset,
+        size_t kernel_offset,
+        size_t count
+    ) const
+    {
+        using product_type = decltype(std::declval<T>() * std::declval<K>());
+
+        const auto buffer_spans = spans();
+        const auto kernel_spans = kernel.spans();
+
+        const auto tail_of = [](const auto& spans, const size_t offset) {
+            return offset < spans.first.size()
+                ? spans.first.subspan(offset)
+                : spans.second.subspan(offset - spans.first.size());
+        };
+
+        // Walk both buffers in runs which are contiguous in each, at most three.
+        product_type result(0);
+        while(count > 0)
+        {
+            const auto values = tail_of(buffer_spans, buffer_offset);
+            const auto weights = tail_of(kernel_spans, kernel_offset);
+            const size_t run = std::min({count, values.size(), weights.size()});
+
+            result += accumulate_lanes<product_type>(run, [&](const size_t i){
+                return values[i] * weights[i];
+            });
+
+            buffer_offset += run;
+            kernel_offset += run;
+            count -= run;
+        }
+
+        return result;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
 	template<typename T>
@@ -435,6 +513,70 @@ namespace lvk
 		return buffer;
 	}
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline T StreamBuffer<T>::sum() const requires std::is_arithmetic_v<T>
+    {
+        const auto [first, second] = spans();
+        return accumulate_lanes<T>(first.size(), [data = first](const size_t i){ return data[i]; })
+             + accumulate_lanes<T>(second.size(), [data = second](const size_t i){ return data[i]; });
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline T StreamBuffer<T>::mean() const requires std::floating_point<T>
+    {
+        if(is_empty()) return T(0);
+
+        return sum() / static_cast<T>(size());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline T StreamBuffer<T>::variance() const requires std::floating_point<T>
+    {
+        if(is_empty()) return T(0);
+
+        // NOTE: This is the population variance, over all the elements in the buffer.
+        const T average = mean();
+        const auto squared_deviation = [average](const std::span<const T> data) {
+            return accumulate_lanes<T>(data.size(), [&](const size_t i){
+                return (data[i] - average) * (data[i] - average);
+            });
+        };
+
+        const auto [first, second] = spans();
+        return (squared_deviation(first) + squared_deviation(second)) / static_cast<T>(size());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline std::pair<std::span<T>, std::span<T>> StreamBuffer<T>::spans()
+    {
+        // Elements run from the start index to the end of the internal buffer, then wrap to its front.
+        const size_t first_size = std::min(m_Size, m_Capacity - m_StartIndex);
+        return {
+            std::span<T>(m_InternalBuffer.data() + m_StartIndex, first_size),
+            std::span<T>(m_InternalBuffer.data(), m_Size - first_size)
+        };
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline std::pair<std::span<const T>, std::span<const T>> StreamBuffer<T>::spans() const
+    {
+        const size_t first_size = std::min(m_Size, m_Capacity - m_StartIndex);
+        return {
+            std::span<const T>(m_InternalBuffer.data() + m_StartIndex, first_size),
+            std::span<const T>(m_InternalBuffer.data(), m_Size - first_size)
+        };
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     template<typename T>
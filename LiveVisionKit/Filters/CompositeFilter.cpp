@@ -119,6 +119,15 @@ namespace lvk
         return m_FilterOutputs[index];
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void CompositeFilter::notify_gap(const size_t dropped_frames)
+    {
+        for(size_t i = 0; i < m_Settings.filter_chain.size(); i++)
+            if(is_filter_enabled(i))
+                m_Settings.filter_chain[i]->notify_gap(dropped_frames);
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     bool CompositeFilter::is_filter_enabled(const size_t index)
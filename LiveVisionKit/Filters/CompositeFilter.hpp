@@ -64,6 +64,8 @@ namespace lvk
 
         size_t filter_count() const;
 
+        void notify_gap(const size_t dropped_frames) override;
+
     private:
 
         void filter(VideoFrame&& input, VideoFrame& output) override;
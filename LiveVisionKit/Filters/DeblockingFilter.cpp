@@ -27,6 +27,11 @@ namespace lvk
 	DeblockingFilter::DeblockingFilter(DeblockingFilterSettings settings)
 		: VideoFilter("Deblocking Filter")
 	{
+        m_SmoothingStage = register_stage("smoothing");
+        m_ReferenceStage = register_stage("reference");
+        m_BlendMapStage = register_stage("blend maps");
+        m_BlendingStage = register_stage("blending");
+
         configure(settings);
 	}
 
@@ -71,19 +76,27 @@ namespace lvk
 		auto filter_input = input(m_FilterRegion);
 
 		// Generate smooth frame
+        auto& smoothing_counters = profile_stage(m_SmoothingStage);
+        smoothing_counters.start();
 		const float area_scaling = 1.0f / m_Settings.filter_scaling;
 		cv::resize(filter_input, m_DeblockBuffer, cv::Size(), area_scaling, area_scaling, cv::INTER_AREA);
 		cv::medianBlur(m_DeblockBuffer, m_DeblockBuffer, static_cast<int>(m_Settings.filter_size));
 		cv::resize(m_DeblockBuffer, m_SmoothFrame, m_FilterRegion.size(), 0, 0, cv::INTER_LINEAR);
+        smoothing_counters.stop();
 
 		// Generate reference frame
+        auto& reference_counters = profile_stage(m_ReferenceStage);
+        reference_counters.start();
         filter_input.reformatTo(m_DetectionFrame, VideoFrame::GRAY);
 		cv::resize(m_DetectionFrame, m_BlockGrid, macroblock_extent, 0, 0, cv::INTER_AREA);
 		cv::resize(m_BlockGrid, m_ReferenceFrame, m_DetectionFrame.size(), 0, 0, cv::INTER_NEAREST);
 		cv::absdiff(m_DetectionFrame, m_ReferenceFrame, m_DetectionFrame);
 		cv::resize(m_DetectionFrame, m_BlockGrid, macroblock_extent, 0, 0, cv::INTER_AREA);
+        reference_counters.stop();
 
 		// Produce blend maps
+        auto& blend_map_counters = profile_stage(m_BlendMapStage);
+        blend_map_counters.start();
 		m_FloatBuffer.create(macroblock_extent, CV_32FC1);
 		m_FloatBuffer.setTo(cv::Scalar(0.0));
 
@@ -96,8 +109,11 @@ namespace lvk
 
 		cv::resize(m_FloatBuffer, m_KeepBlendMap, filter_input.size(), 0, 0, cv::INTER_LINEAR);
 		cv::absdiff(m_KeepBlendMap, cv::Scalar(1.0), m_DeblockBlendMap);
+        blend_map_counters.stop();
 
 		// Adaptively blend original and smooth frames
+        auto& blending_counters = profile_stage(m_BlendingStage);
+        blending_counters.start();
 		cv::blendLinear(
             filter_input,
             m_SmoothFrame,
@@ -105,6 +121,7 @@ namespace lvk
             m_DeblockBlendMap,
             filter_input
 		);
+        blending_counters.stop();
 
         output = std::move(input);
 	}
@@ -48,6 +48,8 @@ namespace lvk
         void filter(VideoFrame&& input, VideoFrame& output) override;
 
         cv::Rect m_FilterRegion{0,0,0,0};
+        size_t m_SmoothingStage = 0, m_ReferenceStage = 0;
+        size_t m_BlendMapStage = 0, m_BlendingStage = 0;
 		VideoFrame m_SmoothFrame, m_DetectionFrame, m_ReferenceFrame;
 		cv::UMat m_BlockMask{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
 		cv::UMat m_KeepBlendMap{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
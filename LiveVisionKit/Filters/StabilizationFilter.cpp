@@ -34,6 +34,10 @@ namespace lvk
 	StabilizationFilter::StabilizationFilter(const StabilizationFilterSettings& settings)
 		: VideoFilter("Stabilization Filter")
 	{
+        m_TrackingStage = register_stage("tracking");
+        m_SmoothingStage = register_stage("smoothing");
+        m_WarpingStage = register_stage("warping");
+
 		configure(settings);
 	}
 
@@ -95,8 +99,11 @@ namespace lvk
         }
 
         // Track the motion of the incoming frame.
+        auto& tracking_counters = profile_stage(m_TrackingStage);
+        tracking_counters.start();
         input.viewAsFormat(m_TrackingFrame, VideoFrame::GRAY);
         auto motion = m_FrameTracker.track(m_TrackingFrame).value_or(m_NullMotion);
+        tracking_counters.stop();
 
         // Apply quality assurance policies
         const auto tracking_quality = m_FrameTracker.tracking_stability();
@@ -117,8 +124,13 @@ namespace lvk
         // Push the tracked frame onto the queue to be stabilized later.
         m_FrameQueue.push(std::move(input));
 
+        auto& smoothing_counters = profile_stage(m_SmoothingStage);
+        smoothing_counters.start();
+        auto correction = m_PathSmoother.next(motion);
+        smoothing_counters.stop();
+
         // If the time delay is built up, start stabilizing frames
-        if(auto correction = m_PathSmoother.next(motion); ready())
+        if(ready())
         {
             // Reference the next frame then skip the buffer by one.
             // This will shorten the queue without de-allocating.
@@ -129,7 +141,11 @@ namespace lvk
             {
                 correction += m_PathSmoother.scene_crop();
             }
+
+            auto& warping_counters = profile_stage(m_WarpingStage);
+            warping_counters.start();
             correction.apply(next_frame, output, m_Settings.background_colour);
+            warping_counters.stop();
         }
         else output.release();
 	}
@@ -143,6 +159,19 @@ namespace lvk
         reset_context();
 	}
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StabilizationFilter::notify_gap(const size_t dropped_frames)
+    {
+        // Motion can't be tracked across the gap, so the tracker must start over. The path is
+        // kept if the gap is shorter than the smoothing window, as it still relates to the scene.
+        // The queued frames are always kept, restarting fully would only lose more frames of output.
+        if(dropped_frames >= frame_delay())
+            reset_context();
+        else
+            m_FrameTracker.restart();
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     bool StabilizationFilter::ready() const
@@ -194,6 +223,20 @@ namespace lvk
         return m_PathSmoother.time_delay();
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    float StabilizationFilter::scene_quality() const
+    {
+        return m_SceneQuality;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    float StabilizationFilter::tracking_stability() const
+    {
+        return m_FrameTracker.tracking_stability();
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
 	cv::Rect StabilizationFilter::stable_region() const
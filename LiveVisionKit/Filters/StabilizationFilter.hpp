@@ -53,12 +53,18 @@ namespace lvk
 
 		void reset_context();
 
+        void notify_gap(const size_t dropped_frames) override;
+
         void draw_trackers();
 
         void draw_motion_mesh();
 
         size_t frame_delay() const;
 
+        float scene_quality() const;
+
+        float tracking_stability() const;
+
 		cv::Rect stable_region() const;
 
 	private:
@@ -75,6 +81,8 @@ namespace lvk
 
         float m_SceneQuality = 0.0f;
         float m_TrustFactor = 0.0f;
+
+        size_t m_TrackingStage = 0, m_SmoothingStage = 0, m_WarpingStage = 0;
     };
 
 }
\ No newline at end of file
@@ -45,8 +45,13 @@ namespace lvk
 
     void VideoFilter::apply(VideoFrame&& input, VideoFrame& output, const bool profile)
     {
+        // Attribute any allocations made during filtering to this filter.
+        TrackingAllocator::Scope allocation_scope(m_MemoryTracker);
+
         m_FrameTimer.sync_gpu(profile).start();
+        m_Counters.start();
         filter(std::move(input), output);
+        m_Counters.stop();
         m_FrameTimer.sync_gpu(profile).stop();
     }
 
@@ -63,28 +68,55 @@ namespace lvk
     {
         LVK_ASSERT(input.isOpened());
 
-        const size_t max_buffer_frames = 15;
+        stream(
+            [&](Frame& read_frame){
+                if(!input.read(read_frame))
+                    return false;
+
+                // Assume the input frame is BGR
+                read_frame.format = VideoFrame::BGR;
+
+                // Set frame timestamp if supported, otherwise set it to zero.
+                const auto stream_position = std::max(0.0, input.get(cv::CAP_PROP_POS_MSEC));
+                read_frame.timestamp = static_cast<uint64_t>(Time::Milliseconds(stream_position).nanoseconds());
+
+                return true;
+            },
+            callback,
+            profile
+        );
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoFilter::stream(
+        const std::function<bool(Frame&)>& input,
+        const std::function<bool(Frame&)>& callback,
+        const bool profile
+    )
+    {
+        LVK_ASSERT(input);
+
+        const size_t max_buffer_frames = m_StreamBufferSize;
 
         std::mutex input_mutex, output_mutex;
         std::queue<Frame> input_queue, output_queue;
+        std::queue<size_t> input_gaps;
 
         std::condition_variable input_consume_flag, output_consume_flag;
         std::condition_variable input_available_flag, output_available_flag;
         std::atomic<bool> input_finished = false, filter_finished = false, terminate_input = false;
 
+        m_StreamStatus.input_queue_depth = 0;
+        m_StreamStatus.output_queue_depth = 0;
+        m_PendingGap = 0;
+
         // Input Processor
-        // This reads frames from the input stream and passes them off for filtering.
+        // This reads frames from the input source and passes them off for filtering.
         auto input_thread = std::thread([&](){
             Frame read_frame;
-            while(input.read(read_frame) && !terminate_input)
+            while(!terminate_input && input(read_frame))
             {
-                // Assume the input frame is BGR
-                read_frame.format = VideoFrame::BGR;
-
-                // Set frame timestamp if supported, otherwise set it to zero.
-                const auto stream_position = std::max(0.0, input.get(cv::CAP_PROP_POS_MSEC));
-                read_frame.timestamp = static_cast<uint64_t>(Time::Milliseconds(stream_position).nanoseconds());
-
                 // Push new frame onto the input queue
                 {
                     std::unique_lock<std::mutex> queue_lock(input_mutex);
@@ -94,6 +126,10 @@ namespace lvk
                         input_consume_flag.wait(queue_lock);
 
                     input_queue.push(std::move(read_frame));
+                    input_gaps.push(m_PendingGap);
+                    m_PendingGap = 0;
+                    m_StreamStatus.input_queue_depth = input_queue.size();
+                    m_StreamStatus.frames_read++;
                     if(input_queue.size() == 1)
                         input_available_flag.notify_one();
                 }
@@ -107,6 +143,7 @@ namespace lvk
         // This grabs frames delivered by the input processor, filters them, and passes them off for output.
         auto filter_thread = std::thread([&](){
             Frame input_frame, filtered_frame;
+            size_t input_gap = 0;
             while(true)
             {
                 // Pop a frame from the input queue
@@ -127,14 +164,27 @@ namespace lvk
 
                     input_frame = std::move(input_queue.front());
                     input_queue.pop();
+                    input_gap = input_gaps.front();
+                    input_gaps.pop();
+                    m_StreamStatus.input_queue_depth = input_queue.size();
 
                     input_consume_flag.notify_one();
                 }
 
-                // Process the frame
+                // Process the frame, after letting the filter know of any frames dropped before it.
+                if(input_gap > 0)
+                    notify_gap(input_gap);
+
                 this->apply(std::move(input_frame), filtered_frame, profile);
+                if(m_StreamObserver)
+                    m_StreamObserver();
+
                 if(filtered_frame.empty())
+                {
+                    m_StreamStatus.frames_dropped++;
                     continue;
+                }
+                m_StreamStatus.frames_filtered++;
 
                 // Push processed frame onto the output queue
                 {
@@ -145,6 +195,7 @@ namespace lvk
                         output_consume_flag.wait(queue_lock);
 
                     output_queue.push(std::move(filtered_frame));
+                    m_StreamStatus.output_queue_depth = output_queue.size();
                     if(output_queue.size() == 1)
                         output_available_flag.notify_one();
                 }
@@ -175,6 +226,7 @@ namespace lvk
 
                 output_frame = std::move(output_queue.front());
                 output_queue.pop();
+                m_StreamStatus.output_queue_depth = output_queue.size();
 
                 output_consume_flag.notify_one();
             }
@@ -191,6 +243,7 @@ namespace lvk
                 {
                     std::unique_lock<std::mutex> queue_lock(input_mutex);
                     while(!input_queue.empty()) input_queue.pop();
+                    while(!input_gaps.empty()) input_gaps.pop();
                     input_consume_flag.notify_one();
                 }
                 input_thread.join();
@@ -208,6 +261,38 @@ namespace lvk
 
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoFilter::notify_gap(const size_t)
+    {
+        // Stateless filters are unaffected by gaps in their input.
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoFilter::mark_stream_gap(const size_t dropped_frames)
+    {
+        m_PendingGap += dropped_frames;
+        m_StreamStatus.frames_skipped += dropped_frames;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoFilter::set_stream_observer(const std::function<void()>& observer)
+    {
+        m_StreamObserver = observer;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoFilter::reset_stream_status()
+    {
+        m_StreamStatus.frames_read = 0;
+        m_StreamStatus.frames_filtered = 0;
+        m_StreamStatus.frames_dropped = 0;
+        m_StreamStatus.frames_skipped = 0;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoFilter::set_timing_samples(const size_t samples)
@@ -217,6 +302,15 @@ namespace lvk
         m_FrameTimer.set_history_size(samples);
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoFilter::set_stream_buffer_size(const size_t frames)
+    {
+        LVK_ASSERT(frames >= 1);
+
+        m_StreamBufferSize = frames;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     const Stopwatch& VideoFilter::timings() const
@@ -224,6 +318,51 @@ namespace lvk
         return m_FrameTimer;
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    const MemoryTracker& VideoFilter::allocations() const
+    {
+        return m_MemoryTracker;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const PerformanceCounters& VideoFilter::counters() const
+    {
+        return m_Counters;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::vector<std::pair<std::string, PerformanceCounters>>& VideoFilter::stage_counters() const
+    {
+        return m_StageCounters;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t VideoFilter::register_stage(const std::string& stage)
+    {
+        m_StageCounters.emplace_back(stage, PerformanceCounters());
+        return m_StageCounters.size() - 1;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    PerformanceCounters& VideoFilter::profile_stage(const size_t stage)
+    {
+        LVK_ASSERT(stage < m_StageCounters.size());
+
+        return m_StageCounters[stage].second;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const StreamStatus& VideoFilter::stream_status() const
+    {
+        return m_StreamStatus;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoFilter::filter(VideoFrame&& input, VideoFrame& output)
@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <vector>
+#include <atomic>
+#include <utility>
 #include <functional>
 #include <opencv2/opencv.hpp>
 #include <opencv2/videoio.hpp>
@@ -24,10 +27,26 @@
 #include "Utility/Unique.hpp"
 #include "Data/VideoFrame.hpp"
 #include "Timing/Stopwatch.hpp"
+#include "Timing/PerformanceCounters.hpp"
+#include "Utility/TrackingAllocator.hpp"
 
 namespace lvk
 {
 
+    // Live statistics of a running stream, safe to read from any thread.
+    struct StreamStatus
+    {
+        std::atomic<size_t> input_queue_depth = 0, output_queue_depth = 0;
+        std::atomic<uint64_t> frames_read = 0, frames_filtered = 0, frames_dropped = 0;
+        std::atomic<uint64_t> frames_skipped = 0; // Dropped by the input before reaching the filter
+
+        StreamStatus() = default;
+
+        // NOTE: copies start with fresh statistics.
+        StreamStatus(const StreamStatus&) {}
+    };
+
+
     // NOTE: standard colour format is YUV.
 	class VideoFilter : public Unique<VideoFilter>
 	{
@@ -46,17 +65,62 @@ namespace lvk
 
         void stream(cv::VideoCapture& input, const std::function<bool(Frame&)>& callback, const bool profile = false);
 
+        void stream(
+            const std::function<bool(Frame&)>& input,
+            const std::function<bool(Frame&)>& callback,
+            const bool profile = false
+        );
+
+
+        // Tells the filter that frames were dropped ahead of its next input.
+        virtual void notify_gap(const size_t dropped_frames);
+
+        // Marks a gap ahead of the frame being read, from within a stream's input function. The
+        // filter is then notified of the gap in order with the frames, on the filtering thread.
+        void mark_stream_gap(const size_t dropped_frames);
+
+        // Sets a function to run on the filtering thread of a stream after each frame is
+        // filtered, so that the state of the filter can be inspected without racing it.
+        void set_stream_observer(const std::function<void()>& observer);
+
+        // Zeroes the frame counts of the stream status, which otherwise add up across streams.
+        void reset_stream_status();
+
 
         void set_timing_samples(const size_t samples);
 
+        // Sets how many frames a stream may read ahead of, or hold behind, the filter.
+        void set_stream_buffer_size(const size_t frames);
+
         const Stopwatch& timings() const;
 
+        const MemoryTracker& allocations() const;
+
+        const PerformanceCounters& counters() const;
+
+        const std::vector<std::pair<std::string, PerformanceCounters>>& stage_counters() const;
+
+        const StreamStatus& stream_status() const;
+
     protected:
 
         virtual void filter(VideoFrame&& input, VideoFrame& output);
 
+        // NOTE: stages must be registered on construction, as the stage counters
+        // may be read from other threads while the filter is streaming.
+        size_t register_stage(const std::string& stage);
+
+        PerformanceCounters& profile_stage(const size_t stage);
+
     private:
         Stopwatch m_FrameTimer;
+        MemoryTracker m_MemoryTracker;
+        PerformanceCounters m_Counters;
+        std::vector<std::pair<std::string, PerformanceCounters>> m_StageCounters;
+        StreamStatus m_StreamStatus;
+        std::function<void()> m_StreamObserver;
+        size_t m_PendingGap = 0;
+        size_t m_StreamBufferSize = 15;
 		const std::string m_Alias;
 	};
 
@@ -20,6 +20,8 @@
 #include <numeric>
 #include <algorithm>
 #include <functional>
+#include <cstdint>
+#include <cstring>
 
 #include "Directives.hpp"
 
@@ -38,6 +40,74 @@ namespace lvk
 		data.pop_back();
 	}
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<bool invert, typename P, typename... T>
+    inline void compact(const std::vector<P>& keep, std::vector<T>&... data)
+    {
+        // Every element is copied down to the next free slot, which only advances past kept
+        // elements. With no branch on the mask, the cost is the same for any inlier ratio
+        // and the loop stays free of mispredictions. The ordering of elements is preserved.
+        size_t size = 0;
+        for(size_t i = 0; i < keep.size(); i++)
+        {
+            ((data[size] = data[i]), ...);
+            size += static_cast<size_t>(invert != static_cast<bool>(keep[i]));
+        }
+
+        (data.resize(size), ...);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<bool invert, typename P>
+    inline bool is_kept_run(const std::vector<P>& keep, const size_t offset)
+    {
+        // Tests eight byte-sized mask elements at once, as a single word. A
+        // run is kept only when none of its bytes are zero (or all are, if inverted).
+        uint64_t word;
+        std::memcpy(&word, keep.data() + offset, sizeof(word));
+
+        if constexpr(invert)
+            return word == 0;
+        else
+            return ((word - 0x0101010101010101ull) & ~word & 0x8080808080808080ull) == 0;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<bool invert, typename P, typename... T>
+    inline void fast_compact(const std::vector<P>& keep, std::vector<T>&... data)
+    {
+        // Removed elements are overwritten by the last kept element. We scan in reverse, so
+        // that the moved elements have already been tested. Byte masks are tested a word at
+        // a time, so that runs of kept elements are skipped without testing each one.
+        constexpr size_t run_length = sizeof(uint64_t);
+        constexpr bool byte_mask = sizeof(P) == 1 && !std::is_same_v<P, bool>;
+
+        size_t size = keep.size(), k = keep.size();
+        while(k > 0)
+        {
+            if constexpr(byte_mask)
+            {
+                if(k >= run_length && is_kept_run<invert>(keep, k - run_length))
+                {
+                    k -= run_length;
+                    continue;
+                }
+            }
+
+            k--;
+            if(invert == static_cast<bool>(keep[k]))
+            {
+                size--;
+                ((data[k] = data[size]), ...);
+            }
+        }
+
+        (data.resize(size), ...);
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     template<typename T, typename P>
@@ -45,12 +115,73 @@ namespace lvk
     {
         LVK_ASSERT(data.size() == keep.size());
 
-        // https://stackoverflow.com/a/33494518
-        const auto predicate = [&](const T& value) {
-            return invert == static_cast<bool>(keep.at(&value - &data[0]));
-        };
+        if constexpr(std::is_trivially_copyable_v<T>)
+        {
+            if(invert) compact<true>(keep, data);
+            else compact<false>(keep, data);
+        }
+        else
+        {
+            // https://stackoverflow.com/a/33494518
+            const auto predicate = [&](const T& value) {
+                return invert == static_cast<bool>(keep.at(&value - &data[0]));
+            };
+
+            data.erase(std::remove_if(data.begin(), data.end(), predicate), data.end());
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T1, typename T2, typename P>
+    inline void filter(
+            std::vector<T1>& data_1,
+            std::vector<T2>& data_2,
+            const std::vector<P>& keep,
+            bool invert
+    )
+    {
+        LVK_ASSERT(data_1.size() == keep.size());
+        LVK_ASSERT(data_2.size() == keep.size());
+
+        if constexpr(std::is_trivially_copyable_v<T1> && std::is_trivially_copyable_v<T2>)
+        {
+            if(invert) compact<true>(keep, data_1, data_2);
+            else compact<false>(keep, data_1, data_2);
+        }
+        else
+        {
+            filter(data_1, keep, invert);
+            filter(data_2, keep, invert);
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T1, typename T2, typename T3, typename P>
+    inline void filter(
+            std::vector<T1>& data_1,
+            std::vector<T2>& data_2,
+            std::vector<T3>& data_3,
+            const std::vector<P>& keep,
+            bool invert
+    )
+    {
+        LVK_ASSERT(data_1.size() == keep.size());
+        LVK_ASSERT(data_2.size() == keep.size());
+        LVK_ASSERT(data_3.size() == keep.size());
 
-        data.erase(std::remove_if(data.begin(), data.end(), predicate), data.end());
+        if constexpr(std::is_trivially_copyable_v<T1> && std::is_trivially_copyable_v<T2> && std::is_trivially_copyable_v<T3>)
+        {
+            if(invert) compact<true>(keep, data_1, data_2, data_3);
+            else compact<false>(keep, data_1, data_2, data_3);
+        }
+        else
+        {
+            filter(data_1, keep, invert);
+            filter(data_2, keep, invert);
+            filter(data_3, keep, invert);
+        }
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -60,11 +191,20 @@ namespace lvk
 	{
 		LVK_ASSERT(data.size() == keep.size());
 
-		// We need to filter in reverse so that the fast erase doesn't affect
-        // the data and keep element correspondence of unprocessed elements.
-		for(int k = keep.size() - 1; k >= 0; k--)
-			if(invert == static_cast<bool>(keep[k]))
-				fast_erase(data, k);
+        // Types which are cheap to copy are overwritten rather than swapped.
+        if constexpr(std::is_trivially_copyable_v<T>)
+        {
+            if(invert) fast_compact<true>(keep, data);
+            else fast_compact<false>(keep, data);
+        }
+        else
+        {
+            // We need to filter in reverse so that the fast erase doesn't affect
+            // the data and keep element correspondence of unprocessed elements.
+            for(int k = keep.size() - 1; k >= 0; k--)
+                if(invert == static_cast<bool>(keep[k]))
+                    fast_erase(data, k);
+        }
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -80,15 +220,24 @@ namespace lvk
 		LVK_ASSERT(data_1.size() == keep.size());
 		LVK_ASSERT(data_2.size() == keep.size());
 
-        // We need to filter in reverse so that the fast erase doesn't affect
-        // the data and keep element correspondence of unprocessed elements.
-		for(int k = keep.size() - 1; k >= 0; k--)
+        // Types which are cheap to copy are overwritten rather than swapped.
+        if constexpr(std::is_trivially_copyable_v<T1> && std::is_trivially_copyable_v<T2>)
+        {
+            if(invert) fast_compact<true>(keep, data_1, data_2);
+            else fast_compact<false>(keep, data_1, data_2);
+        }
+        else
         {
-			if(invert == static_cast<bool>(keep[k]))
-			{
-				fast_erase(data_1, k);
-				fast_erase(data_2, k);
-			}
+            // We need to filter in reverse so that the fast erase doesn't affect
+            // the data and keep element correspondence of unprocessed elements.
+            for(int k = keep.size() - 1; k >= 0; k--)
+            {
+                if(invert == static_cast<bool>(keep[k]))
+                {
+                    fast_erase(data_1, k);
+                    fast_erase(data_2, k);
+                }
+            }
         }
 	}
 
@@ -107,15 +256,24 @@ namespace lvk
         LVK_ASSERT(data_2.size() == keep.size());
         LVK_ASSERT(data_3.size() == keep.size());
 
-        // We need to filter in reverse so that the fast erase doesn't affect
-        // the data and keep element correspondence of unprocessed elements.
-        for(int k = keep.size() - 1; k >= 0; k--)
+        // Types which are cheap to copy are overwritten rather than swapped.
+        if constexpr(std::is_trivially_copyable_v<T1> && std::is_trivially_copyable_v<T2> && std::is_trivially_copyable_v<T3>)
         {
-            if(invert == static_cast<bool>(keep[k]))
+            if(invert) fast_compact<true>(keep, data_1, data_2, data_3);
+            else fast_compact<false>(keep, data_1, data_2, data_3);
+        }
+        else
+        {
+            // We need to filter in reverse so that the fast erase doesn't affect
+            // the data and keep element correspondence of unprocessed elements.
+            for(int k = keep.size() - 1; k >= 0; k--)
             {
-                fast_erase(data_1, k);
-                fast_erase(data_2, k);
-                fast_erase(data_3, k);
+                if(invert == static_cast<bool>(keep[k]))
+                {
+                    fast_erase(data_1, k);
+                    fast_erase(data_2, k);
+                    fast_erase(data_3, k);
+                }
             }
         }
     }
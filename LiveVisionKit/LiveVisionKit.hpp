@@ -52,9 +52,11 @@
 #include "Timing/Time.hpp"
 #include "Timing/Stopwatch.hpp"
 #include "Timing/TickTimer.hpp"
+#include "Timing/PerformanceCounters.hpp"
 
 #include "Utility/Unique.hpp"
 #include "Utility/Configurable.hpp"
+#include "Utility/TrackingAllocator.hpp"
 
 #include "Vision/FrameTracker.hpp"
 #include "Vision/PathSmoother.hpp"
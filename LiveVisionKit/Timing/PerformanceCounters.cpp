@@ -0,0 +1,271 @@
+//    *************************** LiveVisionKit ****************************
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+#include "PerformanceCounters.hpp"
+
+#include <atomic>
+#include <array>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace lvk
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    static std::atomic<bool> s_CountersEnabled = false;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifdef __linux__
+
+    // A group of counters for the calling thread, read all at once so that they cover the same interval.
+    class CounterGroup
+    {
+    public:
+
+        CounterGroup()
+        {
+            const std::array<std::pair<uint32_t, uint64_t>, 4> events = {{
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}
+            }};
+
+            // The cycle counter leads the group, if it is not available then nothing is.
+            for(size_t i = 0; i < events.size(); i++)
+            {
+                perf_event_attr attributes{};
+                attributes.size = sizeof(perf_event_attr);
+                attributes.type = events[i].first;
+                attributes.config = events[i].second;
+                attributes.disabled = (m_Leader == -1) ? 1 : 0;
+                attributes.exclude_kernel = 1;
+                attributes.exclude_hv = 1;
+                attributes.read_format = PERF_FORMAT_GROUP;
+
+                // Measure the calling thread on any CPU.
+                const auto fd = static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, m_Leader, 0));
+                if(fd == -1)
+                {
+                    if(m_Leader == -1) return;
+                    continue;
+                }
+
+                if(m_Leader == -1) m_Leader = fd;
+                m_Descriptors[i] = fd;
+                m_GroupIndex[i] = m_GroupSize++;
+            }
+
+            ioctl(m_Leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(m_Leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+
+        ~CounterGroup()
+        {
+            for(const auto fd : m_Descriptors)
+                if(fd != -1) close(fd);
+        }
+
+        bool is_open() const
+        {
+            return m_Leader != -1;
+        }
+
+        CounterSample read_counters() const
+        {
+            CounterSample sample;
+            if(!is_open()) return sample;
+
+            // Group read format is the number of counters followed by their values.
+            std::array<uint64_t, 5> buffer{};
+            if(::read(m_Leader, buffer.data(), sizeof(buffer)) <= 0)
+                return sample;
+
+            const auto value_of = [&](const size_t event){
+                return m_Descriptors[event] == -1 ? 0 : buffer[1 + m_GroupIndex[event]];
+            };
+
+            sample.cycles = value_of(0);
+            sample.instructions = value_of(1);
+            sample.llc_misses = value_of(2);
+            sample.branch_misses = value_of(3);
+            return sample;
+        }
+
+    private:
+        int m_Leader = -1;
+        size_t m_GroupSize = 0;
+        std::array<int, 4> m_Descriptors = {-1, -1, -1, -1};
+        std::array<size_t, 4> m_GroupIndex = {0, 0, 0, 0};
+    };
+
+    // Counters are per-thread, so each thread lazily opens its own group.
+    static const CounterGroup& thread_counters()
+    {
+        thread_local CounterGroup counters;
+        return counters;
+    }
+
+#endif
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    CounterSample CounterSample::operator-(const CounterSample& other) const
+    {
+        return {
+            cycles - other.cycles,
+            instructions - other.instructions,
+            llc_misses - other.llc_misses,
+            branch_misses - other.branch_misses
+        };
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void CounterSample::operator+=(const CounterSample& other)
+    {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        llc_misses += other.llc_misses;
+        branch_misses += other.branch_misses;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PerformanceCounters::IsSupported()
+    {
+#ifdef __linux__
+        return thread_counters().is_open();
+#else
+        return false;
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PerformanceCounters::IsEnabled()
+    {
+        return s_CountersEnabled;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PerformanceCounters::SetEnabled(const bool enabled)
+    {
+        s_CountersEnabled = enabled;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    CounterSample PerformanceCounters::Sample()
+    {
+#ifdef __linux__
+        if(s_CountersEnabled)
+            return thread_counters().read_counters();
+#endif
+        return {};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PerformanceCounters::start()
+    {
+        if(!s_CountersEnabled)
+            return;
+
+        m_Running = true;
+        m_StartSample = Sample();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    CounterSample PerformanceCounters::stop()
+    {
+        if(!m_Running)
+            return {};
+
+        const CounterSample delta = Sample() - m_StartSample;
+        m_Running = false;
+
+        m_Total += delta;
+        m_SampleCount++;
+
+        return delta;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PerformanceCounters::reset()
+    {
+        m_Running = false;
+        m_SampleCount = 0;
+        m_Total = {};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const CounterSample& PerformanceCounters::total() const
+    {
+        return m_Total;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t PerformanceCounters::sample_count() const
+    {
+        return m_SampleCount;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double PerformanceCounters::instructions_per_cycle() const
+    {
+        if(m_Total.cycles == 0)
+            return 0.0;
+
+        return static_cast<double>(m_Total.instructions) / static_cast<double>(m_Total.cycles);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double PerformanceCounters::llc_misses_per_sample() const
+    {
+        if(m_SampleCount == 0)
+            return 0.0;
+
+        return static_cast<double>(m_Total.llc_misses) / static_cast<double>(m_SampleCount);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double PerformanceCounters::branch_misses_per_sample() const
+    {
+        if(m_SampleCount == 0)
+            return 0.0;
+
+        return static_cast<double>(m_Total.branch_misses) / static_cast<double>(m_SampleCount);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
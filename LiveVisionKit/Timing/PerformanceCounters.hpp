@@ -0,0 +1,77 @@
+//    *************************** LiveVisionKit ****************************
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+#pragma once
+
+#include <cstdint>
+
+namespace lvk
+{
+
+    struct CounterSample
+    {
+        uint64_t cycles = 0;
+        uint64_t instructions = 0;
+        uint64_t llc_misses = 0;
+        uint64_t branch_misses = 0;
+
+        CounterSample operator-(const CounterSample& other) const;
+
+        void operator+=(const CounterSample& other);
+    };
+
+
+    // Accumulates hardware performance counters between start() and stop() calls on the same
+    // thread, much like a Stopwatch. Counters are only sampled when globally enabled, and are
+    // currently only supported on Linux through perf_event_open. Otherwise they read as zero.
+    class PerformanceCounters
+    {
+    public:
+
+        static bool IsSupported();
+
+        static bool IsEnabled();
+
+        static void SetEnabled(const bool enabled);
+
+        static CounterSample Sample();
+
+
+        void start();
+
+        CounterSample stop();
+
+        void reset();
+
+
+        const CounterSample& total() const;
+
+        uint64_t sample_count() const;
+
+        double instructions_per_cycle() const;
+
+        double llc_misses_per_sample() const;
+
+        double branch_misses_per_sample() const;
+
+    private:
+        bool m_Running = false;
+        uint64_t m_SampleCount = 0;
+        CounterSample m_StartSample, m_Total;
+    };
+
+}
@@ -141,7 +141,16 @@ namespace lvk
 
 	Time Stopwatch::average() const
 	{
-		return m_History.is_empty() ? Time(0) : mean(m_History.begin(), m_History.end());
+		if(m_History.is_empty())
+			return Time(0);
+
+		Time total_time(0);
+		const auto [first, second] = m_History.spans();
+		for(const auto& span : {first, second})
+			for(const auto& time : span)
+				total_time += time;
+
+		return total_time / static_cast<double>(m_History.size());
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -154,12 +163,16 @@ namespace lvk
 		const Time average_time = average();
 
 		Time total_deviation(0);
-		for(auto current_time : m_History)
+		const auto [first, second] = m_History.spans();
+		for(const auto& span : {first, second})
 		{
+			for(const auto& current_time : span)
+			{
 				if(average_time > current_time)
-				total_deviation += average_time - current_time;
-			else 
-				total_deviation += current_time - average_time;
+					total_deviation += average_time - current_time;
+				else
+					total_deviation += current_time - average_time;
+			}
 		}
 		
 		return total_deviation / static_cast<double>(m_History.size());
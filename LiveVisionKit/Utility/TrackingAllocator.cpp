@@ -0,0 +1,191 @@
+//    *************************** LiveVisionKit ****************************
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+#include "TrackingAllocator.hpp"
+
+#include <utility>
+
+#include "Directives.hpp"
+
+namespace lvk
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    static thread_local const MemoryTracker* s_ActiveTracker = nullptr;
+
+    static std::atomic<bool> s_AllocatorInstalled = false;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    MemoryTracker::MemoryTracker()
+        : m_Counters(std::make_shared<Counters>())
+    {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    MemoryTracker::MemoryTracker(const MemoryTracker&)
+        : m_Counters(std::make_shared<Counters>())
+    {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    MemoryTracker::MemoryTracker(MemoryTracker&& other)
+        : m_Counters(std::exchange(other.m_Counters, std::make_shared<Counters>()))
+    {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t MemoryTracker::current_bytes() const
+    {
+        return m_Counters->current_bytes;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t MemoryTracker::peak_bytes() const
+    {
+        return m_Counters->peak_bytes;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t MemoryTracker::allocation_count() const
+    {
+        return m_Counters->allocations;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MemoryTracker::reset_peak()
+    {
+        m_Counters->peak_bytes = m_Counters->current_bytes.load();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TrackingAllocator::Install()
+    {
+        // NOTE: the allocator is never destroyed as it must outlive every Mat it allocates.
+        static TrackingAllocator* allocator = new TrackingAllocator(cv::Mat::getStdAllocator());
+
+        if(!s_AllocatorInstalled.exchange(true))
+            cv::Mat::setDefaultAllocator(allocator);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool TrackingAllocator::IsInstalled()
+    {
+        return s_AllocatorInstalled;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TrackingAllocator::Scope::Scope(const MemoryTracker& tracker)
+        : m_PreviousTracker(s_ActiveTracker)
+    {
+        s_ActiveTracker = &tracker;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TrackingAllocator::Scope::~Scope()
+    {
+        s_ActiveTracker = m_PreviousTracker;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TrackingAllocator::TrackingAllocator(cv::MatAllocator* allocator)
+        : m_Allocator(allocator)
+    {
+        LVK_ASSERT(allocator != nullptr);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::UMatData* TrackingAllocator::allocate(
+        int dims,
+        const int* sizes,
+        int type,
+        void* data,
+        size_t* step,
+        cv::AccessFlag flags,
+        cv::UMatUsageFlags usage
+    ) const
+    {
+        cv::UMatData* u = m_Allocator->allocate(dims, sizes, type, data, step, flags, usage);
+        if(u == nullptr)
+            return nullptr;
+
+        // Route the deallocation back through us.
+        u->currAllocator = this;
+
+        // Only count memory which was actually allocated, not user provided.
+        if(data == nullptr && s_ActiveTracker != nullptr)
+        {
+            auto& owner = s_ActiveTracker->m_Counters;
+
+            const size_t current_bytes = owner->current_bytes += u->size;
+            owner->allocations++;
+
+            size_t peak_bytes = owner->peak_bytes;
+            while(current_bytes > peak_bytes && !owner->peak_bytes.compare_exchange_weak(peak_bytes, current_bytes));
+
+            std::scoped_lock lock(m_AllocationMutex);
+            m_Allocations.emplace(u, Allocation{owner, u->size});
+            m_LiveAllocations++;
+        }
+
+        return u;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool TrackingAllocator::allocate(cv::UMatData* data, cv::AccessFlag flags, cv::UMatUsageFlags usage) const
+    {
+        return m_Allocator->allocate(data, flags, usage);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TrackingAllocator::deallocate(cv::UMatData* data) const
+    {
+        if(data != nullptr && m_LiveAllocations > 0)
+        {
+            std::scoped_lock lock(m_AllocationMutex);
+            if(const auto entry = m_Allocations.find(data); entry != m_Allocations.end())
+            {
+                entry->second.owner->current_bytes -= entry->second.bytes;
+                m_Allocations.erase(entry);
+                m_LiveAllocations--;
+            }
+        }
+
+        m_Allocator->deallocate(data);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::BufferPoolController* TrackingAllocator::getBufferPoolController(const char* id) const
+    {
+        return m_Allocator->getBufferPoolController(id);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,128 @@
+//    *************************** LiveVisionKit ****************************
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <unordered_map>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace lvk
+{
+
+    // Accumulates the Mat allocations made while it is the active scope of the TrackingAllocator.
+    class MemoryTracker
+    {
+    public:
+
+        MemoryTracker();
+
+        // NOTE: copies start with fresh statistics.
+        MemoryTracker(const MemoryTracker& other);
+
+        // NOTE: the moved-from tracker is left with fresh statistics.
+        MemoryTracker(MemoryTracker&& other);
+
+
+        size_t current_bytes() const;
+
+        size_t peak_bytes() const;
+
+        size_t allocation_count() const;
+
+        void reset_peak();
+
+    private:
+        friend class TrackingAllocator;
+
+        struct Counters
+        {
+            std::atomic<size_t> current_bytes = 0, peak_bytes = 0, allocations = 0;
+        };
+
+        std::shared_ptr<Counters> m_Counters;
+    };
+
+
+    // Wraps the standard Mat allocator to attribute allocations to the MemoryTracker of the
+    // active scope on the allocating thread. Allocations are always released back to the
+    // tracker which made them, even if it is no longer in scope.
+    //
+    // NOTE: UMats which live on an OpenCL device do not use the Mat allocator and are not tracked.
+    class TrackingAllocator final : public cv::MatAllocator
+    {
+    public:
+
+        static void Install();
+
+        static bool IsInstalled();
+
+
+        class Scope
+        {
+        public:
+
+            explicit Scope(const MemoryTracker& tracker);
+
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            const MemoryTracker* m_PreviousTracker;
+        };
+
+
+        cv::UMatData* allocate(
+            int dims,
+            const int* sizes,
+            int type,
+            void* data,
+            size_t* step,
+            cv::AccessFlag flags,
+            cv::UMatUsageFlags usage
+        ) const override;
+
+        bool allocate(cv::UMatData* data, cv::AccessFlag flags, cv::UMatUsageFlags usage) const override;
+
+        void deallocate(cv::UMatData* data) const override;
+
+        cv::BufferPoolController* getBufferPoolController(const char* id = nullptr) const override;
+
+    private:
+
+        explicit TrackingAllocator(cv::MatAllocator* allocator);
+
+    private:
+        cv::MatAllocator* m_Allocator;
+
+        struct Allocation
+        {
+            std::shared_ptr<MemoryTracker::Counters> owner;
+            size_t bytes;
+        };
+
+        mutable std::mutex m_AllocationMutex;
+        mutable std::unordered_map<const cv::UMatData*, Allocation> m_Allocations;
+        mutable std::atomic<size_t> m_LiveAllocations = 0;
+    };
+
+}
@@ -0,0 +1,152 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include <LiveVisionKit.hpp>
+#include <iostream>
+
+#include "BenchmarkRunner.hpp"
+#include "Benchmarks.hpp"
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void print_manual()
+{
+    std::cout << "Usage: lvk-bench [options]\n\n"
+              << "  -f <filter>   only run cases whose 'name @ variant' contains the filter\n"
+              << "  -i <count>    number of timed iterations per case\n"
+              << "  -w <count>    number of warm-up iterations per case\n"
+              << "  -o <path>     write the results to the given JSON file\n"
+              << "  -b <path>     compare the results against a baseline JSON file\n"
+              << "  -l            list all cases without running them\n"
+              << "  --cpu         disable OpenCL acceleration\n"
+              << "  -h            print this manual\n";
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+std::optional<size_t> parse_count(const std::string& value)
+{
+    try
+    {
+        const auto count = std::stoll(value);
+        if(count >= 0) return static_cast<size_t>(count);
+    }
+    catch(...) {}
+
+    return std::nullopt;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    bench::BenchmarkSettings settings;
+    std::string output_path, baseline_path;
+    bool list_only = false;
+
+    for(int i = 1; i < argc; i++)
+    {
+        const std::string option = argv[i];
+
+        if(option == "-h" || option == "--help")
+        {
+            print_manual();
+            return 0;
+        }
+        else if(option == "-l")
+            list_only = true;
+        else if(option == "--cpu")
+            cv::ocl::setUseOpenCL(false);
+        else if(i + 1 < argc && (option == "-f" || option == "-o" || option == "-b"))
+        {
+            const std::string value = argv[++i];
+            if(option == "-f") settings.case_filter = value;
+            else if(option == "-o") output_path = value;
+            else baseline_path = value;
+        }
+        else if(i + 1 < argc && (option == "-i" || option == "-w"))
+        {
+            const auto count = parse_count(argv[++i]);
+            if(!count.has_value() || (option == "-i" && *count == 0))
+            {
+                std::cerr << cv::format("Invalid count '%s' for option %s\n", argv[i], option.c_str());
+                return 1;
+            }
+            (option == "-i" ? settings.iterations : settings.warmup_iterations) = *count;
+        }
+        else
+        {
+            std::cerr << cv::format("Unknown or incomplete option '%s'\n", option.c_str());
+            print_manual();
+            return 1;
+        }
+    }
+
+    lvk::context::assert_handler = [](auto, auto, const std::string& assertion){
+        std::cerr << cv::format("LiveVisionKit failed condition: %s\n", assertion.c_str());
+        std::abort();
+    };
+
+    bench::BenchmarkRunner runner(settings);
+    bench::register_image_benchmarks(runner);
+    bench::register_vision_benchmarks(runner);
+    bench::register_data_benchmarks(runner);
+
+    if(list_only)
+    {
+        for(const auto& name : runner.case_names())
+            std::cout << name << "\n";
+        return 0;
+    }
+
+    std::cout << cv::format(
+        "Running %zu cases (%zu iterations, %zu warm-up, OpenCL %s)\n\n",
+        runner.case_names().size(), settings.iterations, settings.warmup_iterations,
+        cv::ocl::useOpenCL() ? "enabled" : "disabled"
+    );
+
+    runner.run([](const bench::BenchmarkResult& result){
+        std::cout << cv::format(
+            "%-32s %-12s median %9.3fms  mean %9.3fms  dev %8.3fms  min %9.3fms  max %9.3fms\n",
+            result.name.c_str(), result.variant.c_str(),
+            result.median.milliseconds(), result.mean.milliseconds(), result.deviation.milliseconds(),
+            result.min.milliseconds(), result.max.milliseconds()
+        );
+    });
+
+    if(!output_path.empty())
+    {
+        if(auto error = runner.write_json(output_path); error.has_value())
+        {
+            std::cerr << *error << "\n";
+            return 1;
+        }
+    }
+
+    if(!baseline_path.empty())
+    {
+        if(auto error = runner.compare_json(baseline_path, std::cout); error.has_value())
+        {
+            std::cerr << *error << "\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,226 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "BenchmarkRunner.hpp"
+
+#include <unordered_map>
+#include <algorithm>
+#include <iomanip>
+
+namespace bench
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr int JSON_FORMAT_VERSION = 1;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    BenchmarkRunner::BenchmarkRunner(const BenchmarkSettings& settings)
+        : m_Settings(settings)
+    {
+        LVK_ASSERT(settings.iterations > 0);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void BenchmarkRunner::add(const std::string& name, const std::string& variant, const CaseFactory& factory)
+    {
+        LVK_ASSERT(factory);
+
+        m_Cases.push_back({name, variant, factory});
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::vector<BenchmarkResult>& BenchmarkRunner::run(const std::function<void(const BenchmarkResult&)>& callback)
+    {
+        m_Results.clear();
+        for(const auto& benchmark : m_Cases)
+        {
+            if(!is_selected(benchmark))
+                continue;
+
+            m_Results.push_back(run_case(benchmark));
+            if(callback) callback(m_Results.back());
+        }
+        return m_Results;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    BenchmarkResult BenchmarkRunner::run_case(const BenchmarkCase& benchmark)
+    {
+        // Re-seed before every case so that its synthetic inputs are
+        // identical between runs, regardless of which cases were selected.
+        cv::setRNGSeed(static_cast<int>(m_Settings.seed));
+
+        // The case is only constructed now so that its buffers are freed once it finishes.
+        CaseBody body = benchmark.factory();
+        LVK_ASSERT(body);
+
+        // Warm up any caches, lazily compiled kernels and allocations.
+        for(size_t i = 0; i < m_Settings.warmup_iterations; i++)
+            body();
+
+        // Time each iteration individually, syncing with the GPU so
+        // that asynchronous OpenCL work is attributed to its iteration.
+        lvk::Stopwatch timer(m_Settings.iterations);
+        for(size_t i = 0; i < m_Settings.iterations; i++)
+        {
+            timer.sync_gpu().start();
+            body();
+            timer.sync_gpu().stop();
+        }
+
+        std::vector<lvk::Time> samples;
+        samples.reserve(timer.history().size());
+        for(const auto& sample : timer.history())
+            samples.push_back(sample);
+        std::sort(samples.begin(), samples.end());
+
+        BenchmarkResult result;
+        result.name = benchmark.name;
+        result.variant = benchmark.variant;
+        result.iterations = samples.size();
+        result.mean = timer.average();
+        result.deviation = timer.deviation();
+        result.median = samples[samples.size() / 2];
+        result.min = samples.front();
+        result.max = samples.back();
+
+        return result;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool BenchmarkRunner::is_selected(const BenchmarkCase& benchmark) const
+    {
+        if(m_Settings.case_filter.empty())
+            return true;
+
+        return benchmark.name.find(m_Settings.case_filter) != std::string::npos
+            || benchmark.variant.find(m_Settings.case_filter) != std::string::npos;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::vector<BenchmarkResult>& BenchmarkRunner::results() const
+    {
+        return m_Results;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t BenchmarkRunner::case_count() const
+    {
+        return m_Cases.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<std::string> BenchmarkRunner::case_names() const
+    {
+        std::vector<std::string> names;
+        for(const auto& benchmark : m_Cases)
+            if(is_selected(benchmark))
+                names.push_back(benchmark.name + " @ " + benchmark.variant);
+
+        return names;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> BenchmarkRunner::write_json(const std::filesystem::path& path) const
+    {
+        cv::FileStorage file(path.string(), cv::FileStorage::WRITE | cv::FileStorage::FORMAT_JSON);
+        if(!file.isOpened())
+            return cv::format("Failed to open benchmark output \'%s\'", path.string().c_str());
+
+        // Record the environment so that results are only compared like for like.
+        file << "version" << JSON_FORMAT_VERSION;
+        file << "timestamp" << lvk::Time::Timestamp();
+        file << "opencl" << static_cast<int>(cv::ocl::useOpenCL());
+        file << "threads" << cv::getNumThreads();
+        file << "seed" << static_cast<int>(m_Settings.seed);
+        file << "iterations" << static_cast<int>(m_Settings.iterations);
+        file << "warmup_iterations" << static_cast<int>(m_Settings.warmup_iterations);
+
+        file << "results" << "[";
+        for(const auto& result : m_Results)
+        {
+            file << "{"
+                 << "name" << result.name
+                 << "variant" << result.variant
+                 << "iterations" << static_cast<int>(result.iterations)
+                 << "mean_ms" << result.mean.milliseconds()
+                 << "median_ms" << result.median.milliseconds()
+                 << "deviation_ms" << result.deviation.milliseconds()
+                 << "min_ms" << result.min.milliseconds()
+                 << "max_ms" << result.max.milliseconds()
+                 << "}";
+        }
+        file << "]";
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> BenchmarkRunner::compare_json(
+        const std::filesystem::path& baseline,
+        std::ostream& stream
+    ) const
+    {
+        cv::FileStorage file(baseline.string(), cv::FileStorage::READ | cv::FileStorage::FORMAT_JSON);
+        if(!file.isOpened())
+            return cv::format("Failed to open benchmark baseline \'%s\'", baseline.string().c_str());
+
+        const cv::FileNode baseline_results = file["results"];
+        if(!baseline_results.isSeq())
+            return cv::format("Benchmark baseline \'%s\' has no results", baseline.string().c_str());
+
+        // Medians are compared as they are less susceptible to scheduling noise than the mean.
+        std::unordered_map<std::string, double> baseline_medians;
+        for(const cv::FileNode node : baseline_results)
+            baseline_medians[node["name"].string() + " @ " + node["variant"].string()] = node["median_ms"].real();
+
+        stream << "\nComparison against \'" << baseline.string() << "\' (median):\n";
+        for(const auto& result : m_Results)
+        {
+            const auto key = result.name + " @ " + result.variant;
+            stream << "   " << std::left << std::setw(56) << key << std::right;
+
+            if(const auto entry = baseline_medians.find(key); entry != baseline_medians.end() && entry->second > 0.0)
+            {
+                const double current = result.median.milliseconds();
+                const double change = 100.0 * (current - entry->second) / entry->second;
+
+                stream << std::fixed << std::setprecision(3)
+                       << std::setw(10) << entry->second << "ms -> "
+                       << std::setw(10) << current << "ms  "
+                       << std::showpos << std::setprecision(1) << change << "%" << std::noshowpos
+                       << "\n";
+            }
+            else stream << "   (no baseline)\n";
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,112 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <filesystem>
+#include <functional>
+#include <type_traits>
+#include <optional>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+
+    // A case body is the operation being timed, it is created by a case factory right
+    // before the case is run so that large buffers (e.g. 4K frames) are only held in
+    // memory while their case is being benchmarked.
+    using CaseBody = std::function<void()>;
+    using CaseFactory = std::function<CaseBody()>;
+
+    // Case bodies must pass their results through here, so that the compiler can't
+    // discard them and optimize away the work being benchmarked along with them.
+    template<typename T>
+    inline void do_not_optimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        // Larger objects can't be held in a register, so are only ever referenced in memory.
+        if constexpr(std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*))
+            asm volatile("" : : "r,m"(value) : "memory");
+        else
+            asm volatile("" : : "m"(value) : "memory");
+#else
+        static volatile const void* sink = nullptr;
+        sink = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    struct BenchmarkSettings
+    {
+        size_t iterations = 50;
+        size_t warmup_iterations = 5;
+        uint64_t seed = 0x4C564B;
+        std::string case_filter;
+    };
+
+    struct BenchmarkResult
+    {
+        std::string name;
+        std::string variant;
+        size_t iterations = 0;
+
+        lvk::Time mean, median, deviation, min, max;
+    };
+
+    class BenchmarkRunner
+    {
+    public:
+
+        explicit BenchmarkRunner(const BenchmarkSettings& settings = {});
+
+        void add(const std::string& name, const std::string& variant, const CaseFactory& factory);
+
+        const std::vector<BenchmarkResult>& run(const std::function<void(const BenchmarkResult&)>& callback = {});
+
+        const std::vector<BenchmarkResult>& results() const;
+
+        size_t case_count() const;
+
+        std::vector<std::string> case_names() const;
+
+
+        std::optional<std::string> write_json(const std::filesystem::path& path) const;
+
+        std::optional<std::string> compare_json(const std::filesystem::path& baseline, std::ostream& stream) const;
+
+    private:
+
+        struct BenchmarkCase
+        {
+            std::string name, variant;
+            CaseFactory factory;
+        };
+
+        BenchmarkResult run_case(const BenchmarkCase& benchmark);
+
+        bool is_selected(const BenchmarkCase& benchmark) const;
+
+    private:
+        BenchmarkSettings m_Settings;
+        std::vector<BenchmarkCase> m_Cases;
+        std::vector<BenchmarkResult> m_Results;
+    };
+
+}
@@ -0,0 +1,92 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Benchmarks.hpp"
+
+namespace bench
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr int TEXTURE_BLOCK_SIZE = 8;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Mat make_texture(const cv::Size& size, const int margin)
+    {
+        LVK_ASSERT(margin >= 0);
+
+        const cv::Size texture_size(size.width + 2 * margin, size.height + 2 * margin);
+        const cv::Size block_extent(
+            (texture_size.width + TEXTURE_BLOCK_SIZE - 1) / TEXTURE_BLOCK_SIZE,
+            (texture_size.height + TEXTURE_BLOCK_SIZE - 1) / TEXTURE_BLOCK_SIZE
+        );
+
+        // Use the global RNG so the texture follows the runner's seed.
+        cv::Mat blocks(block_extent, CV_8UC3);
+        cv::randu(blocks, cv::Scalar::all(0), cv::Scalar::all(256));
+
+        cv::Mat texture;
+        cv::resize(blocks, texture, block_extent * TEXTURE_BLOCK_SIZE, 0, 0, cv::INTER_NEAREST);
+
+        // Add some fine grained noise so that not all detail sits on the block edges.
+        cv::Mat noise(texture.size(), CV_16SC3);
+        cv::randn(noise, cv::Scalar::all(0), cv::Scalar::all(8));
+        cv::add(texture, noise, texture, cv::noArray(), CV_8UC3);
+
+        return texture(cv::Rect({0, 0}, texture_size)).clone();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    lvk::VideoFrame make_frame(
+        const cv::Mat& texture,
+        const cv::Size& size,
+        const lvk::VideoFrame::Format format,
+        const cv::Point& offset
+    )
+    {
+        LVK_ASSERT(offset.x >= 0 && offset.y >= 0);
+        LVK_ASSERT(offset.x + size.width <= texture.cols);
+        LVK_ASSERT(offset.y + size.height <= texture.rows);
+
+        lvk::VideoFrame frame;
+        texture(cv::Rect(offset, size)).copyTo(frame);
+        frame.format = lvk::VideoFrame::BGR;
+
+        frame.reformat(format);
+        return frame;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const char* format_name(const lvk::VideoFrame::Format format)
+    {
+        switch(format)
+        {
+            case lvk::VideoFrame::BGR: return "BGR";
+            case lvk::VideoFrame::BGRA: return "BGRA";
+            case lvk::VideoFrame::RGB: return "RGB";
+            case lvk::VideoFrame::RGBA: return "RGBA";
+            case lvk::VideoFrame::YUV: return "YUV";
+            case lvk::VideoFrame::GRAY: return "GRAY";
+            default: return "UNKNOWN";
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
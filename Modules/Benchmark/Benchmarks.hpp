@@ -0,0 +1,56 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <utility>
+#include <vector>
+
+#include "BenchmarkRunner.hpp"
+
+namespace bench
+{
+
+    inline const std::vector<std::pair<std::string, cv::Size>> FRAME_RESOLUTIONS = {
+        {"720p", {1280, 720}},
+        {"1080p", {1920, 1080}},
+        {"4K", {3840, 2160}}
+    };
+
+    // Creates a deterministic BGR texture made of random blocks, which has strong corners for
+    // feature detection and blocking artifacts for deblocking. Frames are taken as views on the
+    // texture, so offsetting the view between frames produces a known amount of motion.
+    cv::Mat make_texture(const cv::Size& size, const int margin = 0);
+
+    lvk::VideoFrame make_frame(
+        const cv::Mat& texture,
+        const cv::Size& size,
+        const lvk::VideoFrame::Format format = lvk::VideoFrame::BGR,
+        const cv::Point& offset = {0, 0}
+    );
+
+    const char* format_name(const lvk::VideoFrame::Format format);
+
+
+    void register_image_benchmarks(BenchmarkRunner& runner);
+
+    void register_vision_benchmarks(BenchmarkRunner& runner);
+
+    void register_data_benchmarks(BenchmarkRunner& runner);
+
+}
@@ -0,0 +1,230 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Benchmarks.hpp"
+
+namespace bench
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Matches the default maximum feature density of the FeatureDetector.
+    constexpr float SUPPRESSION_DENSITY = 0.2f;
+    constexpr size_t SPATIAL_SAMPLES = 4096;
+
+    // A typical detection resolution, and the features found per frame at that resolution.
+    const cv::Size DETECTION_RESOLUTION = {480, 270};
+    constexpr size_t DETECTION_SAMPLES = 512;
+
+    // Path smoothing window, timing history and a large buffer respectively.
+    const std::vector<size_t> STREAM_CAPACITIES = {21, 300, 4096};
+
+    // Features tracked per frame, and the fraction which survive filtering.
+    constexpr size_t TRACKED_FEATURES = 1000;
+    const std::vector<float> INLIER_RATIOS = {0.5f, 0.8f, 0.95f};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<cv::Point2f> make_points(const cv::Size& region, const size_t count)
+    {
+        std::vector<cv::Point2f> points(count);
+        for(auto& point : points)
+        {
+            point.x = cv::theRNG().uniform(0.0f, static_cast<float>(region.width));
+            point.y = cv::theRNG().uniform(0.0f, static_cast<float>(region.height));
+        }
+        return points;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void register_data_benchmarks(BenchmarkRunner& runner)
+    {
+        // SpatialMap, sized as the FeatureDetector's suppression grid would be for each resolution.
+        for(const auto& entry : FRAME_RESOLUTIONS)
+        {
+            const std::string label = entry.first;
+            const cv::Size resolution = entry.second;
+
+            const auto make_map = [=](){
+                const cv::Size grid_size(cv::Size2f(resolution) * SUPPRESSION_DENSITY);
+                return lvk::SpatialMap<size_t>(grid_size, cv::Rect({0,0}, resolution));
+            };
+
+            runner.add("spatial-map/place+clear", label, [=](){
+                const auto points = make_points(resolution, SPATIAL_SAMPLES);
+                return [=, map = make_map()]() mutable {
+                    for(size_t i = 0; i < points.size(); i++)
+                        map.try_place(points[i], i);
+                    do_not_optimize(map);
+                    map.clear();
+                };
+            });
+
+            runner.add("spatial-map/contains", label, [=](){
+                const auto points = make_points(resolution, SPATIAL_SAMPLES);
+
+                auto map = make_map();
+                for(size_t i = 0; i < points.size() / 2; i++)
+                    map.try_place(points[i], i);
+
+                return [=](){
+                    size_t hits = 0;
+                    for(const auto& point : points)
+                        hits += map.contains(map.key_of(point));
+                    do_not_optimize(hits);
+                };
+            });
+
+            runner.add("spatial-map/distribution", label, [=](){
+                const auto points = make_points(resolution, SPATIAL_SAMPLES);
+
+                auto map = make_map();
+                for(size_t i = 0; i < points.size(); i++)
+                    map.try_place(points[i], i);
+
+                return [=](){
+                    do_not_optimize(map.distribution_quality());
+                    do_not_optimize(map.distribution_centroid());
+                };
+            });
+        }
+
+        // A full detection cycle on the FeatureDetector's suppression grid. The grid is
+        // sparsely occupied and cleared every frame, so should scale with the feature count.
+        runner.add(
+            "spatial-map/detect-cycle",
+            cv::format("%dx%d", DETECTION_RESOLUTION.width, DETECTION_RESOLUTION.height),
+            [=](){
+                const auto points = make_points(DETECTION_RESOLUTION, DETECTION_SAMPLES);
+                const cv::Size grid_size(cv::Size2f(DETECTION_RESOLUTION) * SUPPRESSION_DENSITY);
+
+                return [=, map = lvk::SpatialMap<size_t>(grid_size, cv::Rect({0,0}, DETECTION_RESOLUTION))]() mutable {
+                    for(size_t i = 0; i < points.size(); i++)
+                    {
+                        const auto key = map.key_of(points[i]);
+                        if(!map.contains(key))
+                            map.emplace_at(key, i);
+                    }
+                    do_not_optimize(map.distribution_quality());
+                    map.clear();
+                };
+            }
+        );
+
+        // StreamBuffer, at the sizes seen in the path smoother and timing histories.
+        for(const auto capacity : STREAM_CAPACITIES)
+        {
+            const std::string label = std::to_string(capacity) + " elements";
+
+            runner.add("stream-buffer/push", label, [=](){
+                return [=, buffer = lvk::StreamBuffer<float>(capacity)]() mutable {
+                    for(size_t i = 0; i < 4 * capacity; i++)
+                        buffer.push(static_cast<float>(i));
+                    do_not_optimize(buffer);
+                };
+            });
+
+            runner.add("stream-buffer/iterate", label, [=](){
+                lvk::StreamBuffer<float> buffer(capacity);
+                for(size_t i = 0; i < capacity + capacity / 2; i++)
+                    buffer.push(cv::theRNG().uniform(0.0f, 1.0f));
+
+                return [=](){
+                    float total = 0.0f;
+                    for(const auto value : buffer)
+                        total += value;
+                    do_not_optimize(total);
+                };
+            });
+
+            runner.add("stream-buffer/convolve", label, [=](){
+                lvk::StreamBuffer<float> buffer(capacity), kernel(capacity);
+                for(size_t i = 0; i < capacity + capacity / 2; i++)
+                    buffer.push(cv::theRNG().uniform(0.0f, 1.0f));
+
+                const cv::Mat gaussian = cv::getGaussianKernel(static_cast<int>(capacity), -1, CV_32F);
+                for(int i = 0; i < gaussian.rows; i++)
+                    kernel.push(gaussian.at<float>(i));
+
+                return [=](){
+                    do_not_optimize(buffer.convolve(kernel));
+                };
+            });
+
+            runner.add("stream-buffer/variance", label, [=](){
+                lvk::StreamBuffer<float> buffer(capacity);
+                for(size_t i = 0; i < capacity + capacity / 2; i++)
+                    buffer.push(cv::theRNG().uniform(0.0f, 1.0f));
+
+                return [=](){
+                    do_not_optimize(buffer.variance());
+                };
+            });
+
+            runner.add("stream-buffer/time-average", label, [=](){
+                lvk::Stopwatch stopwatch(capacity);
+                for(size_t i = 0; i < capacity; i++)
+                {
+                    stopwatch.start();
+                    stopwatch.stop();
+                }
+
+                return [=](){
+                    do_not_optimize(stopwatch.average());
+                    do_not_optimize(stopwatch.deviation());
+                };
+            });
+        }
+
+        // Filtering, as done on the FrameTracker's feature, point and match arrays. The
+        // arrays are restored on each run, which costs the same for both variants.
+        for(const auto ratio : INLIER_RATIOS)
+        {
+            const std::string label = cv::format("%d%% inliers", static_cast<int>(ratio * 100.0f));
+
+            const auto make_filter = [=](const bool preserve_order){
+                const auto points = make_points({1920, 1080}, TRACKED_FEATURES);
+                const std::vector<cv::KeyPoint> features(TRACKED_FEATURES);
+
+                std::vector<uint8_t> status(TRACKED_FEATURES);
+                for(auto& inlier : status)
+                    inlier = cv::theRNG().uniform(0.0f, 1.0f) < ratio;
+
+                return [=, f = features, p = points, m = points]() mutable {
+                    f = features;
+                    p = points;
+                    m = points;
+
+                    if(preserve_order)
+                        lvk::filter(f, p, m, status);
+                    else
+                        lvk::fast_filter(f, p, m, status);
+
+                    do_not_optimize(f);
+                    do_not_optimize(p);
+                    do_not_optimize(m);
+                };
+            };
+
+            runner.add("container/filter", label, [=](){ return make_filter(true); });
+            runner.add("container/fast-filter", label, [=](){ return make_filter(false); });
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,198 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Benchmarks.hpp"
+
+#include <array>
+
+namespace bench
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr std::array<lvk::VideoFrame::Format, 6> FRAME_FORMATS = {
+        lvk::VideoFrame::BGR, lvk::VideoFrame::BGRA,
+        lvk::VideoFrame::RGB, lvk::VideoFrame::RGBA,
+        lvk::VideoFrame::YUV, lvk::VideoFrame::GRAY
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: These stages mirror those found in DeblockingFilter::filter(), using the
+    // default filter settings, so that the cost of each stage can be seen in isolation.
+    struct DeblockingStages
+    {
+        lvk::VideoFrame input, smooth_frame, detection_frame, reference_frame;
+        cv::UMat block_grid, block_mask, float_buffer, deblock_buffer;
+        cv::UMat keep_blend_map, deblock_blend_map;
+
+        lvk::DeblockingFilterSettings settings;
+        cv::Size macroblock_extent;
+        cv::Rect filter_region;
+
+        explicit DeblockingStages(const cv::Size& resolution)
+        {
+            input = make_frame(make_texture(resolution), resolution, lvk::VideoFrame::YUV);
+
+            const int block_size = static_cast<int>(settings.block_size);
+            macroblock_extent = resolution / block_size;
+            filter_region = cv::Rect({0,0}, macroblock_extent * block_size);
+
+            // Run every stage once so the later stages have valid inputs.
+            smooth(); reference(); blend_maps();
+        }
+
+        void smooth()
+        {
+            const float area_scaling = 1.0f / settings.filter_scaling;
+            cv::resize(input(filter_region), deblock_buffer, cv::Size(), area_scaling, area_scaling, cv::INTER_AREA);
+            cv::medianBlur(deblock_buffer, deblock_buffer, static_cast<int>(settings.filter_size));
+            cv::resize(deblock_buffer, smooth_frame, filter_region.size(), 0, 0, cv::INTER_LINEAR);
+        }
+
+        void reference()
+        {
+            input(filter_region).reformatTo(detection_frame, lvk::VideoFrame::GRAY);
+            cv::resize(detection_frame, block_grid, macroblock_extent, 0, 0, cv::INTER_AREA);
+            cv::resize(block_grid, reference_frame, detection_frame.size(), 0, 0, cv::INTER_NEAREST);
+            cv::absdiff(detection_frame, reference_frame, detection_frame);
+            cv::resize(detection_frame, block_grid, macroblock_extent, 0, 0, cv::INTER_AREA);
+        }
+
+        void blend_maps()
+        {
+            float_buffer.create(macroblock_extent, CV_32FC1);
+            float_buffer.setTo(cv::Scalar(0.0));
+
+            const double level_step = 1.0 / settings.detection_levels;
+            for(uint32_t l = 0; l < settings.detection_levels; l++)
+            {
+                cv::threshold(block_grid, block_mask, l, 255, cv::THRESH_BINARY);
+                float_buffer.setTo(cv::Scalar((l + 1.0) * level_step), block_mask);
+            }
+
+            cv::resize(float_buffer, keep_blend_map, filter_region.size(), 0, 0, cv::INTER_LINEAR);
+            cv::absdiff(keep_blend_map, cv::Scalar(1.0), deblock_blend_map);
+        }
+
+        void blend()
+        {
+            auto filter_input = input(filter_region);
+            cv::blendLinear(filter_input, smooth_frame, keep_blend_map, deblock_blend_map, filter_input);
+        }
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void register_image_benchmarks(BenchmarkRunner& runner)
+    {
+        for(const auto& entry : FRAME_RESOLUTIONS)
+        {
+            const std::string label = entry.first;
+            const cv::Size resolution = entry.second;
+
+            // VideoFrame::reformatTo for every format pair.
+            for(const auto src_format : FRAME_FORMATS)
+            {
+                for(const auto dst_format : FRAME_FORMATS)
+                {
+                    if(src_format == dst_format)
+                        continue;
+
+                    runner.add(
+                        cv::format("reformat/%s->%s", format_name(src_format), format_name(dst_format)),
+                        label,
+                        [=](){
+                            auto src = make_frame(make_texture(resolution), resolution, src_format);
+                            return [=, dst = lvk::VideoFrame()]() mutable {
+                                src.reformatTo(dst, dst_format);
+                            };
+                        }
+                    );
+                }
+            }
+
+            // Remap through both the homography (2x2) and offset map (16x16) paths.
+            for(const auto& mesh_size : {cv::Size(2, 2), cv::Size(16, 16)})
+            {
+                runner.add(
+                    cv::format("remap/mesh-%dx%d", mesh_size.width, mesh_size.height),
+                    label,
+                    [=](){
+                        auto src = make_frame(make_texture(resolution), resolution, lvk::VideoFrame::YUV);
+
+                        lvk::WarpMesh mesh(mesh_size);
+                        mesh.rotate(2.0f);
+
+                        return [=, dst = lvk::VideoFrame()]() mutable {
+                            mesh.apply(src, dst);
+                        };
+                    }
+                );
+            }
+
+            runner.add("upscale/1.5x", label, [=](){
+                const cv::Size src_size(resolution.width * 2 / 3, resolution.height * 2 / 3);
+                auto src = make_frame(make_texture(src_size), src_size, lvk::VideoFrame::YUV);
+
+                return [=, dst = cv::UMat()]() mutable {
+                    lvk::upscale(src, dst, resolution, true);
+                };
+            });
+
+            runner.add("sharpen", label, [=](){
+                auto src = make_frame(make_texture(resolution), resolution, lvk::VideoFrame::YUV);
+
+                return [=, dst = cv::UMat()]() mutable {
+                    lvk::sharpen(src, dst, 0.7f);
+                };
+            });
+
+            // DeblockingFilter, both as a whole and stage by stage.
+            runner.add("deblock/filter", label, [=](){
+                auto src = make_frame(make_texture(resolution), resolution, lvk::VideoFrame::YUV);
+                auto filter = std::make_shared<lvk::DeblockingFilter>();
+
+                return [=, dst = lvk::VideoFrame()]() mutable {
+                    filter->apply(src, dst);
+                };
+            });
+
+            runner.add("deblock/smooth", label, [=](){
+                auto stages = std::make_shared<DeblockingStages>(resolution);
+                return [=](){stages->smooth();};
+            });
+
+            runner.add("deblock/reference", label, [=](){
+                auto stages = std::make_shared<DeblockingStages>(resolution);
+                return [=](){stages->reference();};
+            });
+
+            runner.add("deblock/blend-maps", label, [=](){
+                auto stages = std::make_shared<DeblockingStages>(resolution);
+                return [=](){stages->blend_maps();};
+            });
+
+            runner.add("deblock/blend", label, [=](){
+                auto stages = std::make_shared<DeblockingStages>(resolution);
+                return [=](){stages->blend();};
+            });
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
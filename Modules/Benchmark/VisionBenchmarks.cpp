@@ -0,0 +1,111 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Benchmarks.hpp"
+
+namespace bench
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::vector<cv::Size> MOTION_RESOLUTIONS = {{2, 2}, {8, 8}, {16, 16}};
+
+    // Known motion between consecutive frames of a tracking sequence.
+    const cv::Point SEQUENCE_MOTION = {6, 3};
+    constexpr int SEQUENCE_LENGTH = 8;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void register_vision_benchmarks(BenchmarkRunner& runner)
+    {
+        for(const auto& entry : FRAME_RESOLUTIONS)
+        {
+            const std::string label = entry.first;
+            const cv::Size resolution = entry.second;
+
+            runner.add("feature-detector/detect", label, [=](){
+                auto frame = make_frame(make_texture(resolution), resolution, lvk::VideoFrame::GRAY);
+
+                lvk::FeatureDetectorSettings settings;
+                settings.detection_resolution = resolution;
+                auto detector = std::make_shared<lvk::FeatureDetector>(settings);
+
+                return [=, features = std::vector<cv::KeyPoint>()]() mutable {
+                    features.clear();
+                    detector->detect(frame, features);
+                    do_not_optimize(features);
+                };
+            });
+
+            for(const auto& motion_resolution : MOTION_RESOLUTIONS)
+            {
+                runner.add(
+                    cv::format("frame-tracker/track-%dx%d", motion_resolution.width, motion_resolution.height),
+                    label,
+                    [=](){
+                        // Create a sequence of frames which pan across the texture
+                        // by a constant amount, then loop back to the start.
+                        const int margin = SEQUENCE_LENGTH * std::max(SEQUENCE_MOTION.x, SEQUENCE_MOTION.y);
+                        const auto texture = make_texture(resolution, margin);
+
+                        std::vector<lvk::VideoFrame> sequence;
+                        for(int i = 0; i < SEQUENCE_LENGTH; i++)
+                            sequence.push_back(make_frame(texture, resolution, lvk::VideoFrame::GRAY, i * SEQUENCE_MOTION));
+
+                        lvk::FrameTrackerSettings settings;
+                        settings.motion_resolution = motion_resolution;
+                        auto tracker = std::make_shared<lvk::FrameTracker>(settings);
+
+                        return [=, index = size_t(0)]() mutable {
+                            do_not_optimize(tracker->track(sequence[index++ % sequence.size()]));
+                        };
+                    }
+                );
+            }
+        }
+
+        // Path smoothing is independent of the frame resolution.
+        for(const auto& motion_resolution : MOTION_RESOLUTIONS)
+        {
+            runner.add(
+                "path-smoother/next",
+                cv::format("%dx%d mesh", motion_resolution.width, motion_resolution.height),
+                [=](){
+                    std::vector<lvk::WarpMesh> motions;
+                    for(int i = 0; i < SEQUENCE_LENGTH; i++)
+                    {
+                        auto& motion = motions.emplace_back(motion_resolution);
+                        motion.write([](cv::Point2f& offset, const cv::Point&){
+                            offset.x = static_cast<float>(cv::theRNG().uniform(-0.02, 0.02));
+                            offset.y = static_cast<float>(cv::theRNG().uniform(-0.02, 0.02));
+                        }, false);
+                    }
+
+                    lvk::PathSmootherSettings settings;
+                    settings.motion_resolution = motion_resolution;
+                    auto smoother = std::make_shared<lvk::PathSmoother>(settings);
+
+                    return [=, index = size_t(0)]() mutable {
+                        do_not_optimize(smoother->next(motions[index++ % motions.size()]));
+                    };
+                }
+            );
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
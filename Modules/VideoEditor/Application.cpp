@@ -20,6 +20,8 @@
 
 #include "VideoIOConfiguration.hpp"
 #include "VideoProcessor.hpp"
+#include "BatchProcessor.hpp"
+#include "DistributedProcessor.hpp"
 
 #ifdef WIN32
 #define NOMINMAX
@@ -50,13 +52,35 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    clt::VideoProcessor processor(configuration);
+    // Batch mode runs a separate processor for each of its inputs, and distributed modes one per segment
+    std::optional<clt::VideoProcessor> processor;
+    std::optional<clt::BatchProcessor> batch_processor;
+    std::optional<clt::DistributedProcessor> distributed_processor;
+    if(configuration.batch_output.has_value())
+        batch_processor.emplace(configuration, argc, argv);
+    else if(configuration.plan_manifest.has_value()
+            || configuration.worker_manifest.has_value()
+            || configuration.merge_manifest.has_value())
+        distributed_processor.emplace(configuration, argc, argv);
+    else
+        processor.emplace(configuration);
 
-    // Set up signal to terminate the processor early on ctrl+c
+    // Set up signal to terminate the processor early on ctrl+c, or when preempted
     signal_handler = [&](){
-        processor.stop();
+        if(batch_processor.has_value())
+            batch_processor->stop();
+        else if(distributed_processor.has_value())
+            distributed_processor->stop();
+        else
+            processor->stop();
     };
     signal(SIGINT, [](int s){signal_handler();});
+    signal(SIGTERM, [](int s){signal_handler();});
+
+#ifndef WIN32
+    // Let writes to a closed stdout pipe fail gracefully, instead of killing the process.
+    signal(SIGPIPE, SIG_IGN);
+#endif
 
     // Set up LVK assert handler
     lvk::context::assert_handler = [](auto, auto, const std::string& assertion){
@@ -73,7 +97,15 @@ int main(int argc, char* argv[])
 
 
     // Run the video processor
-    if(auto error = processor.run(); error.has_value())
+    std::optional<std::string> error;
+    if(batch_processor.has_value())
+        error = batch_processor->run();
+    else if(distributed_processor.has_value())
+        error = distributed_processor->run();
+    else
+        error = processor->run();
+
+    if(error.has_value())
     {
         std::cerr << *error << "\n";
         return 1;
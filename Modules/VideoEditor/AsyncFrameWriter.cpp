@@ -0,0 +1,171 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "AsyncFrameWriter.hpp"
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    AsyncFrameWriter::AsyncFrameWriter(const size_t queue_capacity)
+        : m_QueueCapacity(queue_capacity)
+    {
+        LVK_ASSERT(queue_capacity > 0);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    AsyncFrameWriter::~AsyncFrameWriter()
+    {
+        finish();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void AsyncFrameWriter::start(const WriteFunction& writer)
+    {
+        LVK_ASSERT(writer);
+        LVK_ASSERT(!is_running());
+
+        m_Writer = writer;
+        m_Running = true;
+        m_Finishing = false;
+        m_Error.reset();
+
+        m_WriterThread = std::thread(&AsyncFrameWriter::run, this);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool AsyncFrameWriter::write(lvk::Frame&& frame)
+    {
+        std::unique_lock<std::mutex> queue_lock(m_QueueMutex);
+        LVK_ASSERT(m_Running || m_Error.has_value());
+
+        // Block until there is space, or the writer has failed.
+        while(m_Queue.size() >= m_QueueCapacity && !m_Error.has_value())
+            m_SpaceAvailable.wait(queue_lock);
+
+        if(m_Error.has_value())
+            return false;
+
+        m_Queue.push_back(std::move(frame));
+        m_FrameAvailable.notify_one();
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> AsyncFrameWriter::finish()
+    {
+        // Let the writer drain the queue before it exits.
+        {
+            std::scoped_lock queue_lock(m_QueueMutex);
+            m_Finishing = true;
+            m_FrameAvailable.notify_one();
+        }
+
+        if(m_WriterThread.joinable())
+            m_WriterThread.join();
+
+        std::scoped_lock queue_lock(m_QueueMutex);
+        m_Running = false;
+        m_Writer = {};
+
+        return m_Error;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void AsyncFrameWriter::run()
+    {
+        lvk::Frame frame;
+        while(true)
+        {
+            {
+                std::unique_lock<std::mutex> queue_lock(m_QueueMutex);
+                while(m_Queue.empty())
+                {
+                    if(m_Finishing) return;
+                    m_FrameAvailable.wait(queue_lock);
+                }
+
+                frame = std::move(m_Queue.front());
+                m_Queue.pop_front();
+                m_SpaceAvailable.notify_one();
+            }
+
+            try
+            {
+                m_WriteTimer.start();
+                m_Writer(frame);
+                m_WriteTimer.stop();
+            }
+            catch(const std::exception& e)
+            {
+                std::scoped_lock queue_lock(m_QueueMutex);
+                m_Error = cv::format("Failed to write output frame with error \'%s\'", e.what());
+                m_Queue.clear();
+                m_SpaceAvailable.notify_all();
+                return;
+            }
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool AsyncFrameWriter::is_running() const
+    {
+        std::scoped_lock queue_lock(m_QueueMutex);
+        return m_Running;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t AsyncFrameWriter::queue_depth() const
+    {
+        std::scoped_lock queue_lock(m_QueueMutex);
+        return m_Queue.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t AsyncFrameWriter::queue_capacity() const
+    {
+        return m_QueueCapacity;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void AsyncFrameWriter::set_queue_capacity(const size_t capacity)
+    {
+        LVK_ASSERT(capacity > 0);
+        LVK_ASSERT(!is_running());
+
+        m_QueueCapacity = capacity;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const lvk::Stopwatch& AsyncFrameWriter::timings() const
+    {
+        return m_WriteTimer;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,79 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <condition_variable>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <deque>
+
+namespace clt
+{
+
+    // Writes frames on a dedicated thread, so that the caller only waits on the writer
+    // when more than the queue capacity of frames are already in flight. Any error
+    // thrown by the write function stops the writer, and is reported on the next call.
+    class AsyncFrameWriter
+    {
+    public:
+
+        using WriteFunction = std::function<void(const lvk::Frame&)>;
+
+        explicit AsyncFrameWriter(const size_t queue_capacity = 8);
+
+        ~AsyncFrameWriter();
+
+        void start(const WriteFunction& writer);
+
+        bool write(lvk::Frame&& frame);
+
+        std::optional<std::string> finish();
+
+
+        bool is_running() const;
+
+        size_t queue_depth() const;
+
+        size_t queue_capacity() const;
+
+        void set_queue_capacity(const size_t capacity);
+
+        const lvk::Stopwatch& timings() const;
+
+    private:
+
+        void run();
+
+    private:
+        WriteFunction m_Writer;
+        std::thread m_WriterThread;
+        lvk::Stopwatch m_WriteTimer{300};
+
+        mutable std::mutex m_QueueMutex;
+        std::condition_variable m_FrameAvailable, m_SpaceAvailable;
+        std::deque<lvk::Frame> m_Queue;
+        size_t m_QueueCapacity;
+
+        bool m_Running = false, m_Finishing = false;
+        std::optional<std::string> m_Error;
+    };
+
+}
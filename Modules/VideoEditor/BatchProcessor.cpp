@@ -0,0 +1,574 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "BatchProcessor.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <set>
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr auto WORKER_POLL_PERIOD = std::chrono::milliseconds(50);
+    constexpr size_t RECENT_RESULT_COUNT = 10;
+
+    const lvk::Time WATCH_PERIOD = lvk::Time::Milliseconds(50);
+
+    // Only these are picked up from watched directories, which keeps out partial and side files.
+    const std::set<std::string> WATCHED_EXTENSIONS = {
+        ".mp4", ".m4v", ".mkv", ".mov", ".avi", ".webm", ".ts", ".y4m", ".lvkv"
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void replace_all(std::string& string, const std::string& token, const std::string& replacement)
+    {
+        for(size_t position = string.find(token); position != std::string::npos;)
+        {
+            string.replace(position, token.length(), replacement);
+            position = string.find(token, position + replacement.length());
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::filesystem::path make_output_path(const std::string& pattern, const std::filesystem::path& input)
+    {
+        std::string output = pattern;
+        replace_all(output, "{dir}", input.has_parent_path() ? input.parent_path().string() : ".");
+        replace_all(output, "{name}", input.stem().string());
+        replace_all(output, "{ext}", input.extension().string());
+        return output;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    BatchProcessor::BatchProcessor(VideoIOConfiguration configuration, const int argc, char* argv[])
+        : m_Configuration(std::move(configuration)),
+          m_ArgumentCount(argc),
+          m_Arguments(argv)
+    {
+        LVK_ASSERT(m_Configuration.batch_output.has_value());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> BatchProcessor::collect_jobs()
+    {
+        if(m_Configuration.batch_watch)
+            return collect_watched_jobs();
+
+        std::vector<std::filesystem::path> inputs;
+        for(const auto& specifier : m_Configuration.batch_inputs)
+        {
+            if(specifier.find_first_of("*?") != std::string::npos)
+            {
+                std::vector<cv::String> matches;
+                try
+                {
+                    cv::glob(specifier, matches, false);
+                }
+                catch(const cv::Exception&)
+                {
+                    return cv::format("Failed to expand batch input \'%s\'", specifier.c_str());
+                }
+
+                if(matches.empty())
+                    return cv::format("Batch input \'%s\' did not match any files", specifier.c_str());
+
+                std::sort(matches.begin(), matches.end());
+                inputs.insert(inputs.end(), matches.begin(), matches.end());
+            }
+            else if(std::filesystem::path(specifier).extension() == ".txt")
+            {
+                std::ifstream list(specifier);
+                if(!list.good())
+                    return cv::format("Failed to open batch input list \'%s\'", specifier.c_str());
+
+                // One path per line, ignoring blank lines and # comments.
+                for(std::string line; std::getline(list, line);)
+                {
+                    line.erase(0, line.find_first_not_of(" \t"));
+                    line.erase(line.find_last_not_of(" \t\r") + 1);
+
+                    if(!line.empty() && line.front() != '#')
+                        inputs.emplace_back(line);
+                }
+            }
+            else inputs.emplace_back(specifier);
+        }
+
+        if(inputs.empty())
+            return "No batch inputs were found";
+
+        for(const auto& input : inputs)
+        {
+            if(!std::filesystem::is_regular_file(input))
+                return cv::format("Batch input \'%s\' does not exist", input.string().c_str());
+
+            if(auto error = queue_job(input); error.has_value())
+                return error;
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> BatchProcessor::collect_watched_jobs()
+    {
+        std::vector<std::filesystem::path> directories(
+            m_Configuration.batch_inputs.begin(), m_Configuration.batch_inputs.end()
+        );
+
+        // Start watching first, so that no file can arrive unseen between the two.
+        if(auto error = m_Watcher.open(directories); error.has_value())
+            return error;
+
+        // Pick up anything which arrived while we were not running.
+        std::vector<std::filesystem::path> existing;
+        for(const auto& directory : directories)
+        {
+            std::error_code fs_error;
+            for(const auto& entry : std::filesystem::directory_iterator(directory, fs_error))
+                if(entry.is_regular_file(fs_error))
+                    existing.push_back(entry.path());
+        }
+        std::sort(existing.begin(), existing.end());
+
+        for(const auto& input : existing)
+        {
+            if(!is_watched_input(input))
+                continue;
+
+            if(auto error = queue_job(input); error.has_value())
+                return error;
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> BatchProcessor::queue_job(const std::filesystem::path& input)
+    {
+        BatchJob job;
+        job.input = input;
+        job.output = make_output_path(*m_Configuration.batch_output, input);
+
+        std::error_code fs_error;
+        job.input_time = std::filesystem::last_write_time(input, fs_error);
+
+        const auto input_key = input.lexically_normal();
+        const auto output_key = job.output.lexically_normal();
+
+        std::lock_guard lock(m_JobMutex);
+
+        // Watched files can be reported more than once, such as when they arrive during
+        // the initial scan, but any that are already queued or running need no new job.
+        if(m_Configuration.batch_watch && m_PendingInputs.count(input_key) > 0)
+            return std::nullopt;
+
+        // Make sure no two pending jobs, or any job and its input, share a file.
+        if(m_PendingOutputs.count(output_key) > 0 || output_key == input_key)
+        {
+            return cv::format(
+                "Batch output \'%s\' is not unique, use {dir}, {name} and {ext} to distinguish outputs",
+                job.output.string().c_str()
+            );
+        }
+
+        if(job.output.has_parent_path())
+            std::filesystem::create_directories(job.output.parent_path(), fs_error);
+
+        m_PendingInputs.insert(input_key);
+        m_PendingOutputs.insert(output_key);
+        m_Outputs.insert(output_key);
+
+        m_Jobs.emplace(m_JobCount++, std::move(job));
+        m_JobQueued.notify_one();
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool BatchProcessor::is_watched_input(const std::filesystem::path& input) const
+    {
+        // Skip hidden files and our own outputs, which may well be written into a watched directory.
+        const auto name = input.filename().string();
+        if(name.empty() || name.front() == '.')
+            return false;
+
+        {
+            std::lock_guard lock(m_JobMutex);
+            if(m_Outputs.count(input.lexically_normal()) > 0)
+                return false;
+        }
+
+        auto extension = input.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if(WATCHED_EXTENSIONS.count(extension) == 0)
+            return false;
+
+        // Inputs with an output newer than themselves have already been processed.
+        std::error_code fs_error;
+        const auto output = make_output_path(*m_Configuration.batch_output, input);
+        const auto output_time = std::filesystem::last_write_time(output, fs_error);
+
+        return fs_error || output_time < std::filesystem::last_write_time(input, fs_error);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> BatchProcessor::run()
+    {
+        if(auto error = collect_jobs(); error.has_value())
+            return error;
+
+        // Watched batches keep all their workers, as more jobs may arrive.
+        const uint32_t hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        m_CoreBudget = m_Configuration.batch_cores > 0 ? m_Configuration.batch_cores : hardware_threads;
+        m_Concurrency = std::min(m_Configuration.batch_jobs, m_CoreBudget);
+        if(!m_Configuration.batch_watch)
+            m_Concurrency = std::min(m_Concurrency, static_cast<uint32_t>(m_JobCount));
+
+        // OpenCV's worker pool is shared by every job, and each job's filter thread
+        // takes part in its parallel loops, so the pool only makes up the difference.
+        cv::setNumThreads(static_cast<int>(m_CoreBudget - m_Concurrency + 1));
+
+        // Initialize OpenCL before the workers start, so they all share the one context.
+        cv::ocl::useOpenCL();
+
+        m_Terminate = false;
+        m_BatchTimer.start();
+
+        std::vector<std::thread> workers;
+        m_RunningWorkers = m_Concurrency;
+        for(uint32_t i = 0; i < m_Concurrency; i++)
+            workers.emplace_back(&BatchProcessor::run_worker, this);
+
+        lvk::Time last_update_time;
+        while(m_RunningWorkers > 0)
+        {
+            if(m_Watcher.is_open() && !m_Terminate)
+            {
+                for(const auto& input : m_Watcher.wait(WATCH_PERIOD))
+                {
+                    if(!is_watched_input(input))
+                        continue;
+
+                    // A clashing file should not bring down the whole daemon.
+                    if(auto error = queue_job(input); error.has_value())
+                    {
+                        std::lock_guard lock(m_ActiveMutex);
+                        m_RecentResults.push_back("   REJECTED " + input.string() + ": " + *error);
+                    }
+                }
+            }
+            else std::this_thread::sleep_for(WORKER_POLL_PERIOD);
+
+            const auto elapsed_time = m_BatchTimer.elapsed();
+            if(last_update_time.is_zero() || elapsed_time > last_update_time + m_Configuration.update_period)
+            {
+                last_update_time = elapsed_time;
+                print_progress();
+            }
+        }
+
+        for(auto& worker : workers)
+            worker.join();
+
+        m_Watcher.close();
+        m_BatchTimer.stop();
+
+        print_progress();
+        print_results();
+
+        if(m_Configuration.batch_report.has_value())
+        {
+            if(auto error = write_report(); error.has_value())
+                return error;
+        }
+
+        if(m_FailedJobs > 0 || m_FinishedJobs < m_JobCount)
+        {
+            return cv::format(
+                "%zu of %zu batch jobs did not complete",
+                m_JobCount - (m_FinishedJobs - m_FailedJobs),
+                m_JobCount
+            );
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void BatchProcessor::stop()
+    {
+        m_Terminate = true;
+        m_JobQueued.notify_all();
+
+        std::lock_guard lock(m_ActiveMutex);
+        for(auto& [index, processor] : m_ActiveJobs)
+            processor->stop();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<size_t> BatchProcessor::claim_job()
+    {
+        std::unique_lock lock(m_JobMutex);
+
+        // When watching, idle workers wait for more files instead of finishing with the queue.
+        while(!m_Terminate && m_NextJob >= m_JobCount && m_Configuration.batch_watch)
+            m_JobQueued.wait_for(lock, WORKER_POLL_PERIOD);
+
+        if(m_Terminate || m_NextJob >= m_JobCount)
+            return std::nullopt;
+
+        return m_NextJob++;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void BatchProcessor::run_worker()
+    {
+        for(auto index = claim_job(); index.has_value(); index = claim_job())
+            run_job(*index);
+
+        m_RunningWorkers--;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void BatchProcessor::run_job(const size_t index)
+    {
+        BatchJob* job_entry = nullptr;
+        {
+            std::lock_guard lock(m_JobMutex);
+            job_entry = &m_Jobs.at(index);
+        }
+        auto& job = *job_entry;
+
+        lvk::Stopwatch job_timer;
+        job_timer.start();
+
+        VideoIOConfiguration configuration;
+        job.error = configuration.from_command_line(m_ArgumentCount, m_Arguments);
+        if(!job.error.has_value())
+            job.error = configuration.configure_batch_job(job.input, job.output);
+
+        if(!job.error.has_value())
+        {
+            VideoProcessor processor(configuration);
+            {
+                std::lock_guard lock(m_ActiveMutex);
+                m_ActiveJobs.emplace(index, &processor);
+            }
+
+            try
+            {
+                job.error = processor.run();
+            }
+            catch(const std::exception& e)
+            {
+                job.error = cv::format("Processing failed with exception \'%s\'", e.what());
+            }
+
+            {
+                std::lock_guard lock(m_ActiveMutex);
+                m_ActiveJobs.erase(index);
+            }
+
+            // A job cut short by stop() has not processed the whole input.
+            if(m_Terminate && !job.error.has_value())
+                job.error = "Cancelled";
+
+            job.frames = processor.frames_processed();
+        }
+
+        job.elapsed = job_timer.stop();
+        job.finished = true;
+
+        if(job.error.has_value())
+            m_FailedJobs++;
+        m_FinishedJobs++;
+
+        finish_job(index);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void BatchProcessor::finish_job(const size_t index)
+    {
+        std::filesystem::path input;
+        std::filesystem::file_time_type input_time;
+        std::string result;
+        {
+            std::lock_guard lock(m_JobMutex);
+            const auto& job = m_Jobs.at(index);
+
+            m_PendingInputs.erase(job.input.lexically_normal());
+            m_PendingOutputs.erase(job.output.lexically_normal());
+
+            if(!m_Configuration.batch_watch)
+                return;
+
+            // Daemons never reach the final results, so each job is shown as it
+            // finishes then dropped, rather than keeping every job ever given.
+            input = job.input;
+            input_time = job.input_time;
+            result = describe_job(job);
+            m_Jobs.erase(index);
+        }
+
+        {
+            std::lock_guard lock(m_ActiveMutex);
+            m_RecentResults.push_back(std::move(result));
+            if(m_RecentResults.size() > RECENT_RESULT_COUNT)
+                m_RecentResults.pop_front();
+        }
+
+        // The input may have been replaced while it was being processed, which went
+        // ignored as it was already pending, so the new version must be queued here.
+        std::error_code fs_error;
+        const auto current_time = std::filesystem::last_write_time(input, fs_error);
+        if(!m_Terminate && !fs_error && current_time > input_time)
+        {
+            if(auto error = queue_job(input); error.has_value())
+            {
+                std::lock_guard lock(m_ActiveMutex);
+                m_RecentResults.push_back("   REJECTED " + input.string() + ": " + *error);
+            }
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void BatchProcessor::print_progress()
+    {
+        m_ConsoleLogger.clear();
+
+        std::scoped_lock lock(m_ActiveMutex, m_JobMutex);
+
+        m_ConsoleLogger << "Batch: " << static_cast<uint64_t>(m_FinishedJobs) << "/" << m_JobCount << " files"
+                        << " (" << static_cast<uint64_t>(m_FailedJobs) << " failed)"
+                        << "   Jobs: " << m_Concurrency << "   Cores: " << m_CoreBudget
+                        << ConsoleLogger::Next;
+
+        m_ConsoleLogger << "   Elapsed: " << m_BatchTimer.elapsed().hms() << ConsoleLogger::Next;
+
+        if(m_Watcher.is_open())
+        {
+            m_ConsoleLogger << "   Watching: " << m_Configuration.batch_inputs.size() << " directories"
+                            << (m_Watcher.is_polling() ? " (polling)" : " (inotify)")
+                            << ConsoleLogger::Next;
+        }
+
+        for(const auto& [index, processor] : m_ActiveJobs)
+            m_ConsoleLogger << "   Processing: " << m_Jobs.at(index).input.string() << ConsoleLogger::Next;
+
+        if(!m_RecentResults.empty())
+        {
+            m_ConsoleLogger << ConsoleLogger::Next << "Recent: " << ConsoleLogger::Next;
+            for(const auto& result : m_RecentResults)
+                m_ConsoleLogger << result << ConsoleLogger::Next;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void BatchProcessor::print_results()
+    {
+        m_ConsoleLogger << ConsoleLogger::Next << "Results: " << ConsoleLogger::Next;
+        // Watched batches only keep their unfinished jobs, the rest were shown as they finished.
+        for(const auto& [index, job] : m_Jobs)
+            m_ConsoleLogger << describe_job(job) << ConsoleLogger::Next;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::string BatchProcessor::describe_job(const BatchJob& job) const
+    {
+        if(!job.finished)
+            return "   SKIPPED  " + job.input.string();
+
+        if(job.error.has_value())
+            return "   FAILED   " + job.input.string() + ": " + *job.error;
+
+        return "   OK       " + job.input.string() + " -> " + job.output.string()
+            + cv::format(
+                  "  (%llu frames in %s, %.1f FPS)",
+                  static_cast<unsigned long long>(job.frames),
+                  job.elapsed.hms().c_str(),
+                  static_cast<double>(job.frames) / std::max(job.elapsed.seconds(), 1e-9)
+              );
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> BatchProcessor::write_report()
+    {
+        LVK_ASSERT(m_Configuration.batch_report.has_value());
+
+        cv::FileStorage file(
+            m_Configuration.batch_report->string(),
+            cv::FileStorage::WRITE | cv::FileStorage::FORMAT_JSON
+        );
+        if(!file.isOpened())
+        {
+            return cv::format(
+                "Failed to open batch report \'%s\'",
+                m_Configuration.batch_report->string().c_str()
+            );
+        }
+
+        file << "files" << static_cast<int>(m_JobCount)
+             << "failed" << static_cast<int>(m_FailedJobs)
+             << "jobs" << static_cast<int>(m_Concurrency)
+             << "cores" << static_cast<int>(m_CoreBudget)
+             << "wall_time_s" << m_BatchTimer.elapsed().seconds();
+
+        file << "results" << "[";
+        for(const auto& [index, job] : m_Jobs)
+        {
+            const char* status = !job.finished ? "skipped" : (job.error.has_value() ? "failed" : "ok");
+
+            file << "{" << "input" << job.input.string()
+                 << "output" << job.output.string()
+                 << "status" << status
+                 << "frames" << static_cast<double>(job.frames)
+                 << "time_s" << job.elapsed.seconds();
+
+            if(job.error.has_value())
+                file << "error" << *job.error;
+            file << "}";
+        }
+        file << "]";
+
+        file.release();
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
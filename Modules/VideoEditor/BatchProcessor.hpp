@@ -0,0 +1,119 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <condition_variable>
+#include <filesystem>
+#include <optional>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <map>
+#include <set>
+
+#include "VideoIOConfiguration.hpp"
+#include "VideoProcessor.hpp"
+#include "DirectoryWatcher.hpp"
+#include "ConsoleLogger.hpp"
+
+namespace clt
+{
+
+    struct BatchJob
+    {
+        std::filesystem::path input, output;
+        std::filesystem::file_time_type input_time;
+
+        bool finished = false;
+        std::optional<std::string> error;
+        uint64_t frames = 0;
+        lvk::Time elapsed;
+    };
+
+    // Runs a VideoProcessor for each batch input, several at a time, within one process so that
+    // the OpenCL context and its compiled programs are shared between jobs. Every job re-parses
+    // the command line, giving it its own fresh filter chain. When watching, the workers stay
+    // warm and wait for new files to arrive in the input directories.
+    class BatchProcessor
+    {
+    public:
+
+        BatchProcessor(VideoIOConfiguration configuration, const int argc, char* argv[]);
+
+        std::optional<std::string> run();
+
+        void stop();
+
+    private:
+
+        std::optional<std::string> collect_jobs();
+
+        std::optional<std::string> collect_watched_jobs();
+
+        std::optional<std::string> queue_job(const std::filesystem::path& input);
+
+        bool is_watched_input(const std::filesystem::path& input) const;
+
+        std::optional<size_t> claim_job();
+
+        void run_worker();
+
+        void run_job(const size_t index);
+
+        void finish_job(const size_t index);
+
+        std::string describe_job(const BatchJob& job) const;
+
+        void print_progress();
+
+        void print_results();
+
+        std::optional<std::string> write_report();
+
+    private:
+        VideoIOConfiguration m_Configuration;
+        const int m_ArgumentCount;
+        char** m_Arguments;
+
+        ConsoleLogger m_ConsoleLogger;
+        lvk::Stopwatch m_BatchTimer;
+        uint32_t m_Concurrency = 1, m_CoreBudget = 1;
+
+        // Jobs are keyed by the order they were queued in. When watching, finished jobs are
+        // dropped once reported, so that a long-running daemon does not keep every job around.
+        mutable std::mutex m_JobMutex;
+        std::condition_variable m_JobQueued;
+        std::map<size_t, BatchJob> m_Jobs;
+        size_t m_JobCount = 0, m_NextJob = 0;
+
+        // Inputs and outputs of the jobs which are queued or running, and every output ever queued.
+        std::set<std::filesystem::path> m_PendingInputs, m_PendingOutputs, m_Outputs;
+
+        std::atomic<size_t> m_FinishedJobs = 0, m_FailedJobs = 0;
+        std::atomic<uint32_t> m_RunningWorkers = 0;
+
+        DirectoryWatcher m_Watcher;
+        std::deque<std::string> m_RecentResults;
+
+        std::mutex m_ActiveMutex;
+        std::map<size_t, VideoProcessor*> m_ActiveJobs;
+        std::atomic<bool> m_Terminate = false;
+    };
+
+}
@@ -0,0 +1,238 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Checkpoint.hpp"
+
+#include <fstream>
+#include <limits>
+#include <opencv2/opencv.hpp>
+
+#include "RawVideoIO.hpp"
+#include "LosslessVideoIO.hpp"
+#ifdef FFMPEG_BACKEND
+#include "FFmpegVideoIO.hpp"
+#endif
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::filesystem::path Checkpoint::PathFor(const std::filesystem::path& output)
+    {
+        return std::filesystem::path(output).concat(".checkpoint.json");
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::filesystem::path Checkpoint::SegmentPath(const std::filesystem::path& output, const size_t index)
+    {
+        // Segments keep the output's extension, so they are written in the same format.
+        return output.parent_path() / cv::format(
+            "%s.part%04zu%s",
+            output.stem().string().c_str(),
+            index,
+            output.extension().string().c_str()
+        );
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<Checkpoint> Checkpoint::Load(const std::filesystem::path& path)
+    {
+        cv::FileStorage file(path.string(), cv::FileStorage::READ | cv::FileStorage::FORMAT_JSON);
+        if(!file.isOpened())
+            return std::nullopt;
+
+        Checkpoint checkpoint;
+        checkpoint.input = file["input"].string();
+        checkpoint.output = file["output"].string();
+
+        for(const cv::FileNode node : file["segments"])
+        {
+            checkpoint.segments.push_back({
+                node["path"].string(),
+                lvk::Time::Seconds(node["end_s"].real())
+            });
+        }
+
+        return checkpoint;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> Checkpoint::save(const std::filesystem::path& path) const
+    {
+        // Write to a temporary file first, so a crash mid-write can't corrupt the last checkpoint.
+        const auto temp_path = std::filesystem::path(path).concat(".tmp");
+        {
+            cv::FileStorage file(temp_path.string(), cv::FileStorage::WRITE | cv::FileStorage::FORMAT_JSON);
+            if(!file.isOpened())
+                return cv::format("Failed to write checkpoint \'%s\'", path.string().c_str());
+
+            file << "input" << input << "output" << output;
+
+            file << "segments" << "[";
+            for(const auto& segment : segments)
+                file << "{" << "path" << segment.path.string() << "end_s" << segment.end.seconds() << "}";
+            file << "]";
+
+            file << "resume_s" << resume_position().seconds();
+            file.release();
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temp_path, path, error);
+        if(error)
+            return cv::format("Failed to write checkpoint \'%s\'", path.string().c_str());
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    lvk::Time Checkpoint::resume_position() const
+    {
+        return segments.empty() ? lvk::Time() : segments.back().end;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> concat_raw_segments(
+        const std::vector<Checkpoint::Segment>& segments,
+        const std::filesystem::path& output,
+        const bool y4m
+    )
+    {
+        std::ofstream output_file(output, std::ios::binary | std::ios::trunc);
+        if(!output_file.good())
+            return cv::format("Failed to create \'%s\'", output.string().c_str());
+
+        for(size_t i = 0; i < segments.size(); i++)
+        {
+            std::ifstream segment_file(segments[i].path, std::ios::binary);
+            if(!segment_file.good())
+                return cv::format("Failed to open segment \'%s\'", segments[i].path.string().c_str());
+
+            // Only the first Y4M stream header is kept, the rest of the stream is identical.
+            if(y4m && i > 0)
+                segment_file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+            output_file << segment_file.rdbuf();
+        }
+
+        if(!output_file.good())
+            return cv::format("Failed to write \'%s\'", output.string().c_str());
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> reencode_segments(
+        const std::vector<Checkpoint::Segment>& segments,
+        const std::filesystem::path& output
+    )
+    {
+        cv::VideoWriter writer;
+        lvk::Frame frame;
+
+        for(const auto& segment : segments)
+        {
+            cv::VideoCapture reader(segment.path.string(), cv::CAP_FFMPEG);
+            if(!reader.isOpened())
+                return cv::format("Failed to open segment \'%s\'", segment.path.string().c_str());
+
+            while(reader.read(frame))
+            {
+                if(!writer.isOpened())
+                {
+                    writer.open(
+                        output.string(),
+                        cv::CAP_FFMPEG,
+                        static_cast<int>(reader.get(cv::CAP_PROP_FOURCC)),
+                        reader.get(cv::CAP_PROP_FPS),
+                        frame.size()
+                    );
+
+                    if(!writer.isOpened())
+                        return cv::format("Failed to create \'%s\'", output.string().c_str());
+                }
+                writer.write(frame);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> merge_segments(
+        const std::vector<Checkpoint::Segment>& segments,
+        const std::filesystem::path& output
+    )
+    {
+        if(segments.empty())
+            return std::nullopt;
+
+        std::error_code fs_error;
+        if(segments.size() == 1)
+        {
+            std::filesystem::rename(segments.front().path, output, fs_error);
+            if(fs_error)
+                return cv::format("Failed to move segment to \'%s\'", output.string().c_str());
+
+            return std::nullopt;
+        }
+
+        // Raw video is joined byte for byte. Encoded video is re-muxed without decoding where the
+        // FFmpeg backend is available, otherwise OpenCV gives us no choice but to re-encode it.
+        std::optional<std::string> error;
+        if(const auto raw_target = parse_raw_video_target(output.string()))
+            error = concat_raw_segments(segments, output, raw_target->y4m);
+        else if(is_lossless_video(output))
+        {
+            std::vector<std::filesystem::path> paths;
+            for(const auto& segment : segments)
+                paths.push_back(segment.path);
+
+            error = concat_lossless_videos(paths, output);
+        }
+        else
+        {
+#ifdef FFMPEG_BACKEND
+            std::vector<std::filesystem::path> paths;
+            for(const auto& segment : segments)
+                paths.push_back(segment.path);
+
+            error = concat_video_files(paths, output);
+#else
+            error = reencode_segments(segments, output);
+#endif
+        }
+
+        if(error.has_value())
+            return error;
+
+        for(const auto& segment : segments)
+            std::filesystem::remove(segment.path, fs_error);
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,61 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace clt
+{
+
+    // Progress of a long job, saved periodically so that it can be resumed after a crash or
+    // preemption. The output is written in segments which are closed off at each checkpoint,
+    // so a resumed job only re-processes the input following the last completed segment.
+    struct Checkpoint
+    {
+        struct Segment
+        {
+            std::filesystem::path path;
+            lvk::Time end; // Input time of the first frame following the segment
+        };
+
+        std::string input, output;
+        std::vector<Segment> segments;
+
+    public:
+
+        static std::filesystem::path PathFor(const std::filesystem::path& output);
+
+        static std::filesystem::path SegmentPath(const std::filesystem::path& output, const size_t index);
+
+        static std::optional<Checkpoint> Load(const std::filesystem::path& path);
+
+        std::optional<std::string> save(const std::filesystem::path& path) const;
+
+        lvk::Time resume_position() const;
+    };
+
+    // Joins the segments into the output in order, removing them once done.
+    std::optional<std::string> merge_segments(
+        const std::vector<Checkpoint::Segment>& segments,
+        const std::filesystem::path& output
+    );
+
+}
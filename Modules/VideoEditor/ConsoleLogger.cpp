@@ -27,20 +27,20 @@ namespace clt
 {
 //---------------------------------------------------------------------------------------------------------------------
 
-    ConsoleLogger::ConsoleLogger()
-        : lvk::Logger(std::cout)
+    ConsoleLogger::ConsoleLogger(std::ostream& stream)
+        : lvk::Logger(stream)
     {
 #ifdef WIN32
         // If we are in Windows, we need to put the console in virtual terminal mode
         // so that it is capable of understanding ANSI codes and is cross-platform.
-        auto handle = GetStdHandle(STD_OUTPUT_HANDLE);
+        auto handle = GetStdHandle(&stream == &std::cerr ? STD_ERROR_HANDLE : STD_OUTPUT_HANDLE);
         SetConsoleMode(
             handle,
             ENABLE_PROCESSED_OUTPUT | ENABLE_VIRTUAL_TERMINAL_PROCESSING | DISABLE_NEWLINE_AUTO_RETURN
         );
 #endif
 
-        std::cout << "\033[?25l" // Disable cursor
+        stream << "\033[?25l" // Disable cursor
                   << "\033[=7l"; // Disable line wrapping (non-windows)
     }
 
@@ -50,7 +50,7 @@ namespace clt
     {
         // TODO: restore windows console mode
 
-        std::cout << "\033[?25h" // Enable cursor
+        raw() << "\033[?25h" // Enable cursor
                   << "\033[=7h"; // Enable line wrapping (non-windows)
     }
 
@@ -67,10 +67,10 @@ namespace clt
     void ConsoleLogger::clear()
     {
         if(m_LineCount > 0)
-            std::cout << "\033[" << (m_LineCount) << 'A'; // Move cursor up to beginning of log
+            raw() << "\033[" << (m_LineCount) << 'A'; // Move cursor up to beginning of log
 
 
-        std::cout << "\033[0G" // Move cursor to start of line
+        raw() << "\033[0G" // Move cursor to start of line
                   << "\033[0J"; // Delete everything after and including the cursor
 
         m_LineCount = 0;
@@ -0,0 +1,208 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "DirectoryWatcher.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Polling is slow enough that a briefly stalled copy is not mistaken for a finished one.
+    const lvk::Time POLL_PERIOD = lvk::Time::Seconds(1);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    DirectoryWatcher::~DirectoryWatcher()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> DirectoryWatcher::open(const std::vector<std::filesystem::path>& directories)
+    {
+        close();
+
+        for(const auto& directory : directories)
+        {
+            if(!std::filesystem::is_directory(directory))
+                return cv::format("Watched path \'%s\' is not a directory", directory.string().c_str());
+        }
+        m_Directories = directories;
+
+#ifdef __linux__
+        // Files are only reported once their writer closes them, or they are moved in whole.
+        m_Inotify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        for(const auto& directory : m_Directories)
+        {
+            if(m_Inotify < 0)
+                break;
+
+            const int watch = ::inotify_add_watch(m_Inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+            if(watch < 0)
+            {
+                // Likely out of watches, so fall back to polling everything.
+                ::close(m_Inotify);
+                m_Inotify = -1;
+                m_Watches.clear();
+            }
+            else m_Watches.emplace(watch, directory);
+        }
+#endif
+
+        // Take note of the existing files, so only new ones are reported.
+        if(is_polling())
+        {
+            poll_directories();
+            for(auto& [path, state] : m_Files)
+                state.reported = true;
+
+            m_PollTimer.start();
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<std::filesystem::path> DirectoryWatcher::wait(const lvk::Time& timeout)
+    {
+        LVK_ASSERT(is_open());
+
+        std::vector<std::filesystem::path> files;
+
+#ifdef __linux__
+        if(!is_polling())
+        {
+            pollfd descriptor = {m_Inotify, POLLIN, 0};
+            if(::poll(&descriptor, 1, static_cast<int>(timeout.milliseconds())) <= 0)
+                return files;
+
+            alignas(inotify_event) char buffer[16 * 1024];
+            ssize_t length = 0;
+            while((length = ::read(m_Inotify, buffer, sizeof(buffer))) > 0)
+            {
+                for(ssize_t offset = 0; offset < length;)
+                {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                    const auto directory = m_Watches.find(event->wd);
+                    if(directory == m_Watches.end() || event->len == 0 || (event->mask & IN_ISDIR) != 0)
+                        continue;
+
+                    const auto path = directory->second / event->name;
+                    if(std::find(files.begin(), files.end(), path) == files.end())
+                        files.push_back(path);
+                }
+            }
+            return files;
+        }
+#endif
+
+        // A file is complete once its size and modification time hold still between two polls.
+        const auto next_poll = POLL_PERIOD - std::min(m_PollTimer.elapsed(), POLL_PERIOD);
+        std::this_thread::sleep_for(
+            std::chrono::nanoseconds(static_cast<int64_t>(std::min(timeout, next_poll).nanoseconds()))
+        );
+
+        if(m_PollTimer.elapsed() < POLL_PERIOD)
+            return files;
+
+        m_PollTimer.restart();
+        return poll_directories();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<std::filesystem::path> DirectoryWatcher::poll_directories()
+    {
+        std::vector<std::filesystem::path> completed;
+        std::map<std::filesystem::path, FileState> files;
+
+        for(const auto& directory : m_Directories)
+        {
+            std::error_code fs_error;
+            for(const auto& entry : std::filesystem::directory_iterator(directory, fs_error))
+            {
+                if(!entry.is_regular_file(fs_error))
+                    continue;
+
+                FileState state;
+                state.size = entry.file_size(fs_error);
+                state.modified = entry.last_write_time(fs_error);
+
+                if(const auto previous = m_Files.find(entry.path()); previous != m_Files.end())
+                {
+                    const bool settled = previous->second.size == state.size && previous->second.modified == state.modified;
+                    state.reported = previous->second.reported || settled;
+
+                    if(settled && !previous->second.reported)
+                        completed.push_back(entry.path());
+                }
+
+                files.emplace(entry.path(), state);
+            }
+        }
+
+        // Forget any files which were removed.
+        m_Files = std::move(files);
+
+        std::sort(completed.begin(), completed.end());
+        return completed;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void DirectoryWatcher::close()
+    {
+#ifdef __linux__
+        if(m_Inotify >= 0)
+            ::close(m_Inotify);
+#endif
+        m_Inotify = -1;
+        m_Watches.clear();
+        m_Directories.clear();
+        m_Files.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool DirectoryWatcher::is_open() const
+    {
+        return !m_Directories.empty();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool DirectoryWatcher::is_polling() const
+    {
+        return m_Inotify < 0;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,77 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <filesystem>
+#include <optional>
+#include <vector>
+#include <map>
+
+namespace clt
+{
+
+    // Reports files which have finished being written into a set of directories. Linux uses
+    // inotify, while other platforms poll the directories for files whose size has settled.
+    class DirectoryWatcher
+    {
+    public:
+
+        DirectoryWatcher() = default;
+
+        ~DirectoryWatcher();
+
+        DirectoryWatcher(const DirectoryWatcher&) = delete;
+
+        DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+
+        // Files already in the directories are not reported.
+        std::optional<std::string> open(const std::vector<std::filesystem::path>& directories);
+
+        // Blocks for up to the timeout, returning any files completed in that time.
+        std::vector<std::filesystem::path> wait(const lvk::Time& timeout);
+
+        void close();
+
+
+        bool is_open() const;
+
+        bool is_polling() const;
+
+    private:
+
+        std::vector<std::filesystem::path> poll_directories();
+
+    private:
+        struct FileState
+        {
+            uintmax_t size = 0;
+            std::filesystem::file_time_type modified;
+            bool reported = false;
+        };
+
+        std::vector<std::filesystem::path> m_Directories;
+        std::map<std::filesystem::path, FileState> m_Files;
+
+        int m_Inotify = -1;
+        std::map<int, std::filesystem::path> m_Watches;
+        lvk::Stopwatch m_PollTimer;
+    };
+
+}
@@ -0,0 +1,367 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "DistributedProcessor.hpp"
+
+#include <cstdio>
+#include <cmath>
+#include <opencv2/opencv.hpp>
+
+#include "Checkpoint.hpp"
+#ifdef FFMPEG_BACKEND
+#include "FFmpegVideoIO.hpp"
+#endif
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::filesystem::path lock_path(const ManifestSegment& segment)
+    {
+        return std::filesystem::path(segment.output).concat(".lock");
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::filesystem::path done_path(const ManifestSegment& segment)
+    {
+        return std::filesystem::path(segment.output).concat(".done");
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Exclusive creation is atomic, even across most network filesystems, so only one worker can win.
+    bool try_create_marker(const std::filesystem::path& path)
+    {
+        FILE* marker = std::fopen(path.string().c_str(), "wx");
+        if(marker == nullptr)
+            return false;
+
+        std::fclose(marker);
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<JobManifest> JobManifest::Load(const std::filesystem::path& path)
+    {
+        cv::FileStorage file(path.string(), cv::FileStorage::READ | cv::FileStorage::FORMAT_JSON);
+        if(!file.isOpened())
+            return std::nullopt;
+
+        JobManifest manifest;
+        manifest.input = file["input"].string();
+        manifest.output = file["output"].string();
+        manifest.framerate = file["framerate"].real();
+
+        for(const cv::FileNode node : file["arguments"])
+            manifest.arguments.push_back(node.string());
+
+        for(const cv::FileNode node : file["segments"])
+        {
+            auto& segment = manifest.segments.emplace_back();
+            segment.output = node["output"].string();
+            segment.range.start = StreamPosition{node["start_s"].real(), false};
+
+            // The last segment runs to the end of the input.
+            if(const double end = node["end_s"].real(); end > 0.0)
+                segment.range.end = StreamPosition{end, false};
+        }
+
+        if(manifest.input.empty() || manifest.output.empty() || manifest.segments.empty())
+            return std::nullopt;
+
+        return manifest;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> JobManifest::save(const std::filesystem::path& path) const
+    {
+        cv::FileStorage file(path.string(), cv::FileStorage::WRITE | cv::FileStorage::FORMAT_JSON);
+        if(!file.isOpened())
+            return cv::format("Failed to write manifest \'%s\'", path.string().c_str());
+
+        file << "input" << input.string()
+             << "output" << output.string()
+             << "framerate" << framerate;
+
+        file << "arguments" << "[";
+        for(const auto& argument : arguments)
+            file << argument;
+        file << "]";
+
+        file << "segments" << "[";
+        for(const auto& segment : segments)
+        {
+            file << "{" << "output" << segment.output.string()
+                 << "start_s" << segment.range.start.value
+                 << "end_s" << (segment.range.end.has_value() ? segment.range.end->value : -1.0)
+                 << "}";
+        }
+        file << "]";
+
+        file.release();
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    DistributedProcessor::DistributedProcessor(VideoIOConfiguration configuration, const int argc, char* argv[])
+        : m_Configuration(std::move(configuration)),
+          m_ArgumentCount(argc),
+          m_Arguments(argv)
+    {
+        LVK_ASSERT(
+            m_Configuration.plan_manifest.has_value()
+            || m_Configuration.worker_manifest.has_value()
+            || m_Configuration.merge_manifest.has_value()
+        );
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> DistributedProcessor::run()
+    {
+        m_Terminate = false;
+
+        if(m_Configuration.plan_manifest.has_value())
+            return plan();
+        else if(m_Configuration.worker_manifest.has_value())
+            return work();
+        else
+            return merge();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void DistributedProcessor::stop()
+    {
+        m_Terminate = true;
+
+        std::lock_guard lock(m_ActiveMutex);
+        if(m_ActiveProcessor != nullptr)
+            m_ActiveProcessor->stop();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> DistributedProcessor::plan()
+    {
+        JobManifest manifest;
+        manifest.input = std::filesystem::absolute(std::get<std::filesystem::path>(m_Configuration.input_source));
+        manifest.output = std::filesystem::absolute(*m_Configuration.output_target);
+
+        // Probe the length of the input, which must be known up front to split it.
+        double frame_count = 0.0;
+#ifdef FFMPEG_BACKEND
+        FFmpegReader probe;
+        if(auto error = probe.open(manifest.input); error.has_value())
+            return error;
+
+        manifest.framerate = probe.framerate();
+        frame_count = static_cast<double>(probe.frame_count());
+#else
+        cv::VideoCapture probe(manifest.input.string(), cv::CAP_FFMPEG);
+        if(!probe.isOpened())
+            return cv::format("Failed to open the input video \'%s\'", manifest.input.string().c_str());
+
+        manifest.framerate = probe.get(cv::CAP_PROP_FPS);
+        frame_count = probe.get(cv::CAP_PROP_FRAME_COUNT);
+#endif
+        if(manifest.framerate <= 0.0 || frame_count <= 0.0)
+            return cv::format("Failed to determine the length of \'%s\'", manifest.input.string().c_str());
+
+        // Segments overlap by the delay of the stateful filters, so that each worker can warm
+        // them up before its first output frame, and flush them out after its last one. Workers
+        // pre- and post-roll their segment from their own filter chain, so this is only reported.
+        size_t filter_delay = 0;
+        for(const auto& filter : m_Configuration.filter_chain)
+            if(auto stabilizer = std::dynamic_pointer_cast<lvk::StabilizationFilter>(filter))
+                filter_delay += stabilizer->frame_delay();
+        const auto overlap = lvk::Time::Timestep(manifest.framerate) * static_cast<double>(filter_delay);
+
+        // Segment boundaries sit halfway between frames, so no frame can land on both sides.
+        const auto segment_frames = std::max(
+            std::round(m_Configuration.plan_segment_length.seconds() * manifest.framerate), 1.0
+        );
+        for(double first_frame = 0.0; first_frame < frame_count; first_frame += segment_frames)
+        {
+            auto& segment = manifest.segments.emplace_back();
+            segment.output = Checkpoint::SegmentPath(manifest.output, manifest.segments.size() - 1);
+
+            if(first_frame > 0.0)
+                segment.range.start = StreamPosition{(first_frame - 0.5) / manifest.framerate, false};
+
+            if(first_frame + segment_frames < frame_count)
+                segment.range.end = StreamPosition{(first_frame + segment_frames - 0.5) / manifest.framerate, false};
+
+            // Clear out markers left by any previous plan of the same output.
+            std::error_code fs_error;
+            std::filesystem::remove(lock_path(segment), fs_error);
+            std::filesystem::remove(done_path(segment), fs_error);
+        }
+
+        // Workers re-run the same command line, minus the planning options.
+        for(int i = 1; i < m_ArgumentCount; i++)
+        {
+            const std::string argument = m_Arguments[i];
+            if(argument == "--plan" || argument == "--segment-length")
+                i++;
+            else
+                manifest.arguments.push_back(argument);
+        }
+
+        if(auto error = manifest.save(*m_Configuration.plan_manifest); error.has_value())
+            return error;
+
+        std::cout << cv::format(
+            "Planned %zu segments of %.1fs, with %.2fs of overlap.\n"
+            "Process them with --worker %s and join them with --merge %s\n",
+            manifest.segments.size(),
+            segment_frames / manifest.framerate,
+            overlap.seconds(),
+            m_Configuration.plan_manifest->string().c_str(),
+            m_Configuration.plan_manifest->string().c_str()
+        );
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> DistributedProcessor::work()
+    {
+        const auto manifest = JobManifest::Load(*m_Configuration.worker_manifest);
+        if(!manifest.has_value())
+            return cv::format("Failed to load manifest \'%s\'", m_Configuration.worker_manifest->string().c_str());
+
+        size_t processed_segments = 0;
+        for(size_t i = 0; i < manifest->segments.size() && !m_Terminate; i++)
+        {
+            const auto& segment = manifest->segments[i];
+            if(std::filesystem::exists(done_path(segment)) || !try_create_marker(lock_path(segment)))
+                continue;
+
+            std::cout << cv::format("Processing segment %zu/%zu\n", i + 1, manifest->segments.size());
+            const auto error = process_segment(*manifest, i);
+
+            // Unfinished segments are released for another worker to retry.
+            const bool finished = !error.has_value() && !m_Terminate;
+            if(finished)
+            {
+                try_create_marker(done_path(segment));
+                processed_segments++;
+            }
+
+            std::error_code fs_error;
+            std::filesystem::remove(lock_path(segment), fs_error);
+
+            if(error.has_value())
+                return cv::format("Segment %zu failed with error \'%s\'", i + 1, error->c_str());
+        }
+
+        std::cout << cv::format("Processed %zu segments\n", processed_segments);
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> DistributedProcessor::process_segment(const JobManifest& manifest, const size_t index)
+    {
+        const auto& segment = manifest.segments[index];
+
+        // Re-parse the planned command line, giving each segment its own fresh filter chain.
+        std::vector<char*> arguments = {m_Arguments[0]};
+        for(const auto& argument : manifest.arguments)
+            arguments.push_back(const_cast<char*>(argument.c_str()));
+
+        VideoIOConfiguration configuration;
+        if(auto error = configuration.from_command_line(static_cast<int>(arguments.size()), arguments.data()))
+            return error;
+
+        if(auto error = configuration.configure_segment_job(manifest.input, segment.output, segment.range))
+            return error;
+
+        VideoProcessor processor(configuration);
+        {
+            std::lock_guard lock(m_ActiveMutex);
+            m_ActiveProcessor = &processor;
+        }
+
+        std::optional<std::string> error;
+        try
+        {
+            error = processor.run();
+        }
+        catch(const std::exception& e)
+        {
+            error = cv::format("Processing failed with exception \'%s\'", e.what());
+        }
+
+        {
+            std::lock_guard lock(m_ActiveMutex);
+            m_ActiveProcessor = nullptr;
+        }
+
+        return error;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> DistributedProcessor::merge()
+    {
+        const auto manifest = JobManifest::Load(*m_Configuration.merge_manifest);
+        if(!manifest.has_value())
+            return cv::format("Failed to load manifest \'%s\'", m_Configuration.merge_manifest->string().c_str());
+
+        std::vector<Checkpoint::Segment> segments;
+        for(size_t i = 0; i < manifest->segments.size(); i++)
+        {
+            const auto& segment = manifest->segments[i];
+            if(!std::filesystem::exists(done_path(segment)))
+            {
+                return cv::format(
+                    "Segment %zu/%zu has not been processed%s",
+                    i + 1,
+                    manifest->segments.size(),
+                    std::filesystem::exists(lock_path(segment))
+                        ? ", it is claimed by a worker or its lock is stale" : ""
+                );
+            }
+            segments.push_back({segment.output, lvk::Time()});
+        }
+
+        if(auto error = merge_segments(segments, manifest->output); error.has_value())
+            return error;
+
+        std::error_code fs_error;
+        for(const auto& segment : manifest->segments)
+            std::filesystem::remove(done_path(segment), fs_error);
+
+        std::cout << cv::format(
+            "Merged %zu segments into \'%s\'\n",
+            manifest->segments.size(),
+            manifest->output.string().c_str()
+        );
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,85 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <filesystem>
+#include <optional>
+#include <atomic>
+#include <mutex>
+
+#include "VideoIOConfiguration.hpp"
+#include "VideoProcessor.hpp"
+
+namespace clt
+{
+
+    struct ManifestSegment
+    {
+        std::filesystem::path output;
+        StreamRange range;
+    };
+
+    struct JobManifest
+    {
+        std::filesystem::path input, output;
+        std::vector<std::string> arguments; // Command line which each segment is processed with
+        double framerate = 0.0;
+        std::vector<ManifestSegment> segments;
+
+    public:
+
+        static std::optional<JobManifest> Load(const std::filesystem::path& path);
+
+        std::optional<std::string> save(const std::filesystem::path& path) const;
+    };
+
+    // Splits a long job into segments which any number of worker processes, on any machines
+    // sharing the manifest's directory, can process independently. Segments are claimed with
+    // lock files and marked with done files, so the manifest itself is never rewritten.
+    class DistributedProcessor
+    {
+    public:
+
+        DistributedProcessor(VideoIOConfiguration configuration, const int argc, char* argv[]);
+
+        std::optional<std::string> run();
+
+        void stop();
+
+    private:
+
+        std::optional<std::string> plan();
+
+        std::optional<std::string> work();
+
+        std::optional<std::string> merge();
+
+        std::optional<std::string> process_segment(const JobManifest& manifest, const size_t index);
+
+    private:
+        VideoIOConfiguration m_Configuration;
+        const int m_ArgumentCount;
+        char** m_Arguments;
+
+        std::mutex m_ActiveMutex;
+        VideoProcessor* m_ActiveProcessor = nullptr;
+        std::atomic<bool> m_Terminate = false;
+    };
+
+}
@@ -0,0 +1,704 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "FFmpegVideoIO.hpp"
+
+#include <algorithm>
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::string av_error_string(const int error)
+    {
+        char buffer[AV_ERROR_MAX_STRING_SIZE] = {0};
+        av_strerror(error, buffer, sizeof(buffer));
+        return buffer;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Wraps a plane of an AVFrame without copying it.
+    cv::Mat view_plane(const AVFrame* frame, const int plane, const cv::Size& size, const int type)
+    {
+        return {size, type, frame->data[plane], static_cast<size_t>(frame->linesize[plane])};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    FFmpegReader::FFmpegReader()
+        : m_Packet(av_packet_alloc()),
+          m_Frame(av_frame_alloc()),
+          m_ConvertedFrame(av_frame_alloc())
+    {
+        LVK_ASSERT(m_Packet != nullptr && m_Frame != nullptr && m_ConvertedFrame != nullptr);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    FFmpegReader::~FFmpegReader()
+    {
+        close();
+
+        av_packet_free(&m_Packet);
+        av_frame_free(&m_Frame);
+        av_frame_free(&m_ConvertedFrame);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> FFmpegReader::open(
+        const std::filesystem::path& path,
+        const int thread_count,
+        const int thread_type
+    )
+    {
+        LVK_ASSERT(thread_count >= 0);
+
+        close();
+
+        const auto path_string = path.string();
+        if(int error = avformat_open_input(&m_Format, path_string.c_str(), nullptr, nullptr); error < 0)
+        {
+            return cv::format(
+                "Failed to open the input video \'%s\' with error \'%s\'",
+                path_string.c_str(),
+                av_error_string(error).c_str()
+            );
+        }
+
+        if(avformat_find_stream_info(m_Format, nullptr) < 0)
+        {
+            close();
+            return cv::format("Failed to read the stream info of \'%s\'", path_string.c_str());
+        }
+
+#if LIBAVFORMAT_VERSION_MAJOR < 59
+        AVCodec* codec = nullptr;
+#else
+        const AVCodec* codec = nullptr;
+#endif
+        m_StreamIndex = av_find_best_stream(m_Format, AVMEDIA_TYPE_VIDEO, -1, -1, &codec, 0);
+        if(m_StreamIndex < 0 || codec == nullptr)
+        {
+            close();
+            return cv::format("No decodable video stream was found in \'%s\'", path_string.c_str());
+        }
+
+        AVStream* stream = m_Format->streams[m_StreamIndex];
+        m_Decoder = avcodec_alloc_context3(codec);
+        avcodec_parameters_to_context(m_Decoder, stream->codecpar);
+
+        // Frame threading adds a frame of latency per thread, slice threading needs codec support.
+        m_Decoder->thread_count = thread_count;
+        m_Decoder->thread_type = thread_type;
+
+        if(int error = avcodec_open2(m_Decoder, codec, nullptr); error < 0)
+        {
+            close();
+            return cv::format(
+                "Failed to open the \'%s\' decoder with error \'%s\'",
+                codec->name,
+                av_error_string(error).c_str()
+            );
+        }
+
+        m_Resolution = cv::Size(m_Decoder->width, m_Decoder->height);
+
+        const AVRational rate = av_guess_frame_rate(m_Format, stream, nullptr);
+        m_Framerate = rate.num > 0 && rate.den > 0 ? av_q2d(rate) : 30.0;
+
+        // Containers don't always record the frame count, so fall back to an estimate from the duration.
+        m_FrameCount = stream->nb_frames > 0 ? static_cast<uint64_t>(stream->nb_frames) : 0;
+        if(m_FrameCount == 0 && m_Format->duration > 0)
+        {
+            m_FrameCount = static_cast<uint64_t>(
+                static_cast<double>(m_Format->duration) / AV_TIME_BASE * m_Framerate
+            );
+        }
+
+        m_FramesRead = 0;
+        m_Draining = false;
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FFmpegReader::receive_frame()
+    {
+        while(true)
+        {
+            const int result = avcodec_receive_frame(m_Decoder, m_Frame);
+            if(result == 0)
+                return true;
+
+            if(result != AVERROR(EAGAIN) || m_Draining)
+                return false;
+
+            // The decoder needs more input, so feed it the next packet of our stream.
+            if(av_read_frame(m_Format, m_Packet) < 0)
+            {
+                // End of input, flush out any frames still held by the decoder.
+                avcodec_send_packet(m_Decoder, nullptr);
+                m_Draining = true;
+                continue;
+            }
+
+            // NOTE: Corrupt packets are skipped, the decoder will resync on the next keyframe.
+            if(m_Packet->stream_index == m_StreamIndex)
+                avcodec_send_packet(m_Decoder, m_Packet);
+
+            av_packet_unref(m_Packet);
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FFmpegReader::read(lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+
+        if(!receive_frame())
+            return false;
+
+        upload_frame(m_Frame, frame);
+
+        // Timestamps are made relative to the start of the stream, so they line up with seek positions.
+        const AVStream* stream = m_Format->streams[m_StreamIndex];
+        const int64_t start_time = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+        const int64_t pts = m_Frame->best_effort_timestamp;
+        frame.timestamp = pts != AV_NOPTS_VALUE && pts >= start_time
+            ? static_cast<uint64_t>(av_rescale_q(pts - start_time, stream->time_base, {1, 1000000000}))
+            : static_cast<uint64_t>((lvk::Time::Timestep(m_Framerate) * static_cast<double>(m_FramesRead)).nanoseconds());
+
+        av_frame_unref(m_Frame);
+        m_FramesRead++;
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FFmpegReader::seek(const lvk::Time& position)
+    {
+        LVK_ASSERT(is_open());
+
+        const AVStream* stream = m_Format->streams[m_StreamIndex];
+        const int64_t start_time = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+        const int64_t target = start_time + av_rescale_q(
+            static_cast<int64_t>(position.nanoseconds()), {1, 1000000000}, stream->time_base
+        );
+
+        // Seek to the keyframe at or before the target, the caller decodes forward from there.
+        if(av_seek_frame(m_Format, m_StreamIndex, target, AVSEEK_FLAG_BACKWARD) < 0)
+            return false;
+
+        avcodec_flush_buffers(m_Decoder);
+        m_Draining = false;
+        m_FramesRead = static_cast<uint64_t>(position.seconds() * m_Framerate);
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FFmpegReader::upload_frame(const AVFrame* src, lvk::Frame& dst)
+    {
+        const auto format = static_cast<AVPixelFormat>(src->format);
+
+        // Chroma subsampling of the natively supported formats.
+        cv::Size chroma_size;
+        switch(format)
+        {
+            case AV_PIX_FMT_YUV420P:
+            case AV_PIX_FMT_YUVJ420P:
+            case AV_PIX_FMT_NV12:
+                chroma_size = cv::Size((src->width + 1) / 2, (src->height + 1) / 2);
+                break;
+            case AV_PIX_FMT_YUV422P:
+            case AV_PIX_FMT_YUVJ422P:
+                chroma_size = cv::Size((src->width + 1) / 2, src->height);
+                break;
+            case AV_PIX_FMT_YUV444P:
+            case AV_PIX_FMT_YUVJ444P:
+                chroma_size = cv::Size(src->width, src->height);
+                break;
+            case AV_PIX_FMT_GRAY8:
+                break;
+            default:
+            {
+                // Anything else (high bit depths, packed RGB etc.) is converted to 8-bit I420 first.
+                m_Converter = sws_getCachedContext(
+                    m_Converter,
+                    src->width, src->height, format,
+                    src->width, src->height, AV_PIX_FMT_YUV420P,
+                    SWS_POINT, nullptr, nullptr, nullptr
+                );
+                LVK_ASSERT(m_Converter != nullptr);
+
+                m_ConvertedFrame->format = AV_PIX_FMT_YUV420P;
+                m_ConvertedFrame->width = src->width;
+                m_ConvertedFrame->height = src->height;
+                if(m_ConvertedFrame->data[0] == nullptr)
+                    av_frame_get_buffer(m_ConvertedFrame, 0);
+
+                sws_scale(
+                    m_Converter,
+                    src->data, src->linesize, 0, src->height,
+                    m_ConvertedFrame->data, m_ConvertedFrame->linesize
+                );
+
+                upload_frame(m_ConvertedFrame, dst);
+                return;
+            }
+        }
+
+        // Each plane is viewed in place and uploaded once, the chroma is upsampled on the device.
+        view_plane(src, 0, m_Resolution, CV_8UC1).copyTo(m_YPlane);
+
+        if(format == AV_PIX_FMT_GRAY8)
+        {
+            m_ChromaBuffers[0].create(m_Resolution, CV_8UC1);
+            m_ChromaBuffers[0].setTo(cv::Scalar(128));
+            cv::merge(std::vector<cv::UMat>{m_YPlane, m_ChromaBuffers[0], m_ChromaBuffers[0]}, dst);
+        }
+        else if(format == AV_PIX_FMT_NV12)
+        {
+            view_plane(src, 1, chroma_size, CV_8UC2).copyTo(m_UVPlane);
+            cv::resize(m_UVPlane, m_ChromaBuffers[0], m_Resolution, 0, 0, cv::INTER_LINEAR);
+            cv::merge(std::vector<cv::UMat>{m_YPlane, m_ChromaBuffers[0]}, dst);
+        }
+        else
+        {
+            view_plane(src, 1, chroma_size, CV_8UC1).copyTo(m_UPlane);
+            view_plane(src, 2, chroma_size, CV_8UC1).copyTo(m_VPlane);
+
+            if(chroma_size != m_Resolution)
+            {
+                cv::resize(m_UPlane, m_ChromaBuffers[0], m_Resolution, 0, 0, cv::INTER_LINEAR);
+                cv::resize(m_VPlane, m_ChromaBuffers[1], m_Resolution, 0, 0, cv::INTER_LINEAR);
+                cv::merge(std::vector<cv::UMat>{m_YPlane, m_ChromaBuffers[0], m_ChromaBuffers[1]}, dst);
+            }
+            else cv::merge(std::vector<cv::UMat>{m_YPlane, m_UPlane, m_VPlane}, dst);
+        }
+
+        dst.format = lvk::VideoFrame::YUV;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FFmpegReader::close()
+    {
+        avcodec_free_context(&m_Decoder);
+        avformat_close_input(&m_Format);
+
+        sws_freeContext(m_Converter);
+        m_Converter = nullptr;
+
+        av_frame_unref(m_ConvertedFrame);
+        m_StreamIndex = -1;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FFmpegReader::is_open() const
+    {
+        return m_Decoder != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const cv::Size& FFmpegReader::resolution() const
+    {
+        return m_Resolution;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double FFmpegReader::framerate() const
+    {
+        return m_Framerate;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t FFmpegReader::frames_read() const
+    {
+        return m_FramesRead;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t FFmpegReader::frame_count() const
+    {
+        return m_FrameCount;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    AVCodecID FFmpegReader::codec_id() const
+    {
+        return is_open() ? m_Decoder->codec_id : AV_CODEC_ID_NONE;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> concat_video_files(
+        const std::vector<std::filesystem::path>& inputs,
+        const std::filesystem::path& output
+    )
+    {
+        LVK_ASSERT(!inputs.empty());
+
+        const auto output_string = output.string();
+        AVFormatContext* output_format = nullptr;
+        AVFormatContext* input_format = nullptr;
+        AVPacket* packet = av_packet_alloc();
+        bool header_written = false;
+
+        const auto cleanup = [&](std::optional<std::string> error){
+            avformat_close_input(&input_format);
+            if(header_written)
+                av_write_trailer(output_format);
+            if(output_format != nullptr && !(output_format->oformat->flags & AVFMT_NOFILE))
+                avio_closep(&output_format->pb);
+            avformat_free_context(output_format);
+            av_packet_free(&packet);
+            return error;
+        };
+
+        avformat_alloc_output_context2(&output_format, nullptr, nullptr, output_string.c_str());
+        if(output_format == nullptr)
+            return cleanup(cv::format("Unknown output container for \'%s\'", output_string.c_str()));
+
+        // Each input is appended after the last, offsetting its timestamps by the running duration.
+        AVStream* output_stream = nullptr;
+        int64_t offset = 0;
+        for(const auto& input : inputs)
+        {
+            const auto input_string = input.string();
+            if(avformat_open_input(&input_format, input_string.c_str(), nullptr, nullptr) < 0
+                || avformat_find_stream_info(input_format, nullptr) < 0)
+                return cleanup(cv::format("Failed to open \'%s\'", input_string.c_str()));
+
+            const int stream_index = av_find_best_stream(input_format, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+            if(stream_index < 0)
+                return cleanup(cv::format("No video stream was found in \'%s\'", input_string.c_str()));
+            const AVStream* input_stream = input_format->streams[stream_index];
+
+            if(output_stream == nullptr)
+            {
+                output_stream = avformat_new_stream(output_format, nullptr);
+                avcodec_parameters_copy(output_stream->codecpar, input_stream->codecpar);
+                output_stream->codecpar->codec_tag = 0;
+                output_stream->time_base = input_stream->time_base;
+
+                if(!(output_format->oformat->flags & AVFMT_NOFILE)
+                    && avio_open(&output_format->pb, output_string.c_str(), AVIO_FLAG_WRITE) < 0)
+                    return cleanup(cv::format("Failed to create an output stream at \'%s\'", output_string.c_str()));
+
+                if(avformat_write_header(output_format, nullptr) < 0)
+                    return cleanup(cv::format("Failed to write the header of \'%s\'", output_string.c_str()));
+                header_written = true;
+            }
+
+            int64_t input_end = offset;
+            while(av_read_frame(input_format, packet) >= 0)
+            {
+                if(packet->stream_index == stream_index)
+                {
+                    av_packet_rescale_ts(packet, input_stream->time_base, output_stream->time_base);
+                    if(packet->pts != AV_NOPTS_VALUE)
+                    {
+                        packet->pts += offset;
+                        input_end = std::max(input_end, packet->pts + packet->duration);
+                    }
+                    if(packet->dts != AV_NOPTS_VALUE)
+                        packet->dts += offset;
+
+                    packet->stream_index = output_stream->index;
+                    packet->pos = -1;
+
+                    if(int error = av_interleaved_write_frame(output_format, packet); error < 0)
+                    {
+                        av_packet_unref(packet);
+                        return cleanup(cv::format(
+                            "Failed to write \'%s\' with error \'%s\'",
+                            output_string.c_str(),
+                            av_error_string(error).c_str()
+                        ));
+                    }
+                }
+                av_packet_unref(packet);
+            }
+
+            offset = input_end;
+            avformat_close_input(&input_format);
+        }
+
+        return cleanup(std::nullopt);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    FFmpegWriter::FFmpegWriter()
+        : m_Packet(av_packet_alloc()),
+          m_Frame(av_frame_alloc()),
+          m_SourceFrame(av_frame_alloc())
+    {
+        LVK_ASSERT(m_Packet != nullptr && m_Frame != nullptr && m_SourceFrame != nullptr);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    FFmpegWriter::~FFmpegWriter()
+    {
+        close();
+
+        av_packet_free(&m_Packet);
+        av_frame_free(&m_Frame);
+        av_frame_free(&m_SourceFrame);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> FFmpegWriter::open(
+        const std::filesystem::path& path,
+        const cv::Size& resolution,
+        const double framerate,
+        const std::optional<int>& fourcc,
+        const AVCodecID fallback_codec
+    )
+    {
+        LVK_ASSERT(resolution.width > 0 && resolution.height > 0);
+        LVK_ASSERT(framerate > 0);
+
+        close();
+
+        const auto path_string = path.string();
+        avformat_alloc_output_context2(&m_Format, nullptr, nullptr, path_string.c_str());
+        if(m_Format == nullptr)
+            return cv::format("Unknown output container for \'%s\'", path_string.c_str());
+
+        // Resolve the codec, the fourcc is looked up in the same tables that OpenCV uses.
+        AVCodecID codec_id = fallback_codec != AV_CODEC_ID_NONE ? fallback_codec : m_Format->oformat->video_codec;
+        if(fourcc.has_value())
+        {
+            const AVCodecTag* const tag_tables[] = {avformat_get_riff_video_tags(), avformat_get_mov_video_tags(), nullptr};
+            codec_id = av_codec_get_id(tag_tables, static_cast<unsigned int>(*fourcc));
+        }
+
+        const AVCodec* codec = avcodec_find_encoder(codec_id);
+        if(codec == nullptr)
+        {
+            close();
+            return cv::format("No encoder is available for the \'%s\' codec", avcodec_get_name(codec_id));
+        }
+
+        m_Stream = avformat_new_stream(m_Format, nullptr);
+        m_Encoder = avcodec_alloc_context3(codec);
+
+        // Prefer to encode I420, converting only when the encoder can't accept it.
+        AVPixelFormat pixel_format = AV_PIX_FMT_YUV420P;
+        if(codec->pix_fmts != nullptr)
+        {
+            bool supports_i420 = false;
+            for(auto format = codec->pix_fmts; *format != AV_PIX_FMT_NONE; format++)
+                supports_i420 |= *format == AV_PIX_FMT_YUV420P;
+
+            if(!supports_i420)
+                pixel_format = codec->pix_fmts[0];
+        }
+
+        const AVRational rate = av_d2q(framerate, 100000);
+        m_Encoder->width = resolution.width;
+        m_Encoder->height = resolution.height;
+        m_Encoder->pix_fmt = pixel_format;
+        m_Encoder->framerate = rate;
+        m_Encoder->time_base = av_inv_q(rate);
+        m_Encoder->thread_count = 0;
+
+        if(m_Format->oformat->flags & AVFMT_GLOBALHEADER)
+            m_Encoder->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+        if(int error = avcodec_open2(m_Encoder, codec, nullptr); error < 0)
+        {
+            close();
+            return cv::format(
+                "Failed to open the \'%s\' encoder with error \'%s\'",
+                codec->name,
+                av_error_string(error).c_str()
+            );
+        }
+
+        avcodec_parameters_from_context(m_Stream->codecpar, m_Encoder);
+        m_Stream->time_base = m_Encoder->time_base;
+
+        if(!(m_Format->oformat->flags & AVFMT_NOFILE))
+        {
+            if(int error = avio_open(&m_Format->pb, path_string.c_str(), AVIO_FLAG_WRITE); error < 0)
+            {
+                close();
+                return cv::format(
+                    "Failed to create an output stream at \'%s\' with error \'%s\'",
+                    path_string.c_str(),
+                    av_error_string(error).c_str()
+                );
+            }
+        }
+
+        if(int error = avformat_write_header(m_Format, nullptr); error < 0)
+        {
+            close();
+            return cv::format("Failed to write the header of \'%s\'", path_string.c_str());
+        }
+        m_HeaderWritten = true;
+
+        // Frames are downloaded straight into the encoder's I420 planes, unless a conversion is needed.
+        m_Resolution = resolution;
+        m_ChromaSize = cv::Size((resolution.width + 1) / 2, (resolution.height + 1) / 2);
+        m_FrameIndex = 0;
+
+        m_Frame->format = pixel_format;
+        m_Frame->width = resolution.width;
+        m_Frame->height = resolution.height;
+        av_frame_get_buffer(m_Frame, 0);
+
+        if(pixel_format != AV_PIX_FMT_YUV420P)
+        {
+            m_SourceFrame->format = AV_PIX_FMT_YUV420P;
+            m_SourceFrame->width = resolution.width;
+            m_SourceFrame->height = resolution.height;
+            av_frame_get_buffer(m_SourceFrame, 0);
+
+            m_Converter = sws_getContext(
+                resolution.width, resolution.height, AV_PIX_FMT_YUV420P,
+                resolution.width, resolution.height, pixel_format,
+                SWS_POINT, nullptr, nullptr, nullptr
+            );
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FFmpegWriter::write(const lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+        LVK_ASSERT(frame.size() == m_Resolution);
+
+        if(frame.format != lvk::VideoFrame::YUV)
+        {
+            frame.reformatTo(m_YUVFrame, lvk::VideoFrame::YUV);
+            cv::split(m_YUVFrame, m_Planes);
+        }
+        else cv::split(frame, m_Planes);
+
+        cv::resize(m_Planes[1], m_USubPlane, m_ChromaSize, 0, 0, cv::INTER_AREA);
+        cv::resize(m_Planes[2], m_VSubPlane, m_ChromaSize, 0, 0, cv::INTER_AREA);
+
+        // The encoder may still hold a reference to the last frame's buffers.
+        if(int error = av_frame_make_writable(m_Frame); error < 0)
+            throw std::runtime_error(av_error_string(error));
+
+        AVFrame* planes = m_Converter != nullptr ? m_SourceFrame : m_Frame;
+        if(m_Converter != nullptr)
+            av_frame_make_writable(m_SourceFrame);
+
+        auto y_plane = view_plane(planes, 0, m_Resolution, CV_8UC1);
+        auto u_plane = view_plane(planes, 1, m_ChromaSize, CV_8UC1);
+        auto v_plane = view_plane(planes, 2, m_ChromaSize, CV_8UC1);
+        m_Planes[0].copyTo(y_plane);
+        m_USubPlane.copyTo(u_plane);
+        m_VSubPlane.copyTo(v_plane);
+
+        if(m_Converter != nullptr)
+        {
+            sws_scale(
+                m_Converter,
+                m_SourceFrame->data, m_SourceFrame->linesize, 0, m_SourceFrame->height,
+                m_Frame->data, m_Frame->linesize
+            );
+        }
+
+        m_Frame->pts = m_FrameIndex++;
+        encode(m_Frame);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FFmpegWriter::encode(const AVFrame* frame)
+    {
+        if(int error = avcodec_send_frame(m_Encoder, frame); error < 0)
+            throw std::runtime_error(av_error_string(error));
+
+        while(avcodec_receive_packet(m_Encoder, m_Packet) == 0)
+        {
+            av_packet_rescale_ts(m_Packet, m_Encoder->time_base, m_Stream->time_base);
+            m_Packet->stream_index = m_Stream->index;
+
+            const int error = av_interleaved_write_frame(m_Format, m_Packet);
+            av_packet_unref(m_Packet);
+
+            if(error < 0)
+                throw std::runtime_error(av_error_string(error));
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FFmpegWriter::close()
+    {
+        // Flush the encoder and finish the container, if it was ever started.
+        if(m_HeaderWritten)
+        {
+            try
+            {
+                encode(nullptr);
+            }
+            catch(const std::runtime_error&) {}
+
+            av_write_trailer(m_Format);
+            m_HeaderWritten = false;
+        }
+
+        if(m_Format != nullptr && !(m_Format->oformat->flags & AVFMT_NOFILE))
+            avio_closep(&m_Format->pb);
+
+        avcodec_free_context(&m_Encoder);
+        avformat_free_context(m_Format);
+        m_Format = nullptr;
+        m_Stream = nullptr;
+
+        sws_freeContext(m_Converter);
+        m_Converter = nullptr;
+
+        av_frame_unref(m_Frame);
+        av_frame_unref(m_SourceFrame);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FFmpegWriter::is_open() const
+    {
+        return m_Format != nullptr && m_Encoder != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
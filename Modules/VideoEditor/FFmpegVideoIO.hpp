@@ -0,0 +1,160 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <filesystem>
+#include <optional>
+#include <vector>
+#include <atomic>
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+#include <libswscale/swscale.h>
+#include <libavutil/imgutils.h>
+}
+
+namespace clt
+{
+
+    // Decodes video with libavcodec directly, delivering packed YUV VideoFrames straight from the
+    // decoder's planar YUV output. This avoids the BGR conversion of cv::VideoCapture, which the
+    // filters would otherwise immediately undo.
+    class FFmpegReader
+    {
+    public:
+
+        FFmpegReader();
+
+        ~FFmpegReader();
+
+        FFmpegReader(const FFmpegReader&) = delete;
+
+        FFmpegReader& operator=(const FFmpegReader&) = delete;
+
+
+        // A thread count of zero lets the decoder choose its own.
+        std::optional<std::string> open(
+            const std::filesystem::path& path,
+            const int thread_count = 0,
+            const int thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE
+        );
+
+        bool read(lvk::Frame& frame);
+
+        bool seek(const lvk::Time& position);
+
+        void close();
+
+
+        bool is_open() const;
+
+        const cv::Size& resolution() const;
+
+        double framerate() const;
+
+        uint64_t frames_read() const;
+
+        uint64_t frame_count() const;
+
+        AVCodecID codec_id() const;
+
+    private:
+
+        bool receive_frame();
+
+        void upload_frame(const AVFrame* src, lvk::Frame& dst);
+
+    private:
+        AVFormatContext* m_Format = nullptr;
+        AVCodecContext* m_Decoder = nullptr;
+        AVPacket* m_Packet = nullptr;
+        AVFrame *m_Frame = nullptr, *m_ConvertedFrame = nullptr;
+        SwsContext* m_Converter = nullptr;
+        int m_StreamIndex = -1;
+        bool m_Draining = false;
+
+        cv::Size m_Resolution;
+        double m_Framerate = 30.0;
+        uint64_t m_FrameCount = 0;
+        std::atomic<uint64_t> m_FramesRead = 0;
+
+        cv::UMat m_YPlane, m_UPlane, m_VPlane, m_UVPlane;
+        cv::UMat m_ChromaBuffers[2];
+    };
+
+
+    // Joins video files of the same format into the output, copying their packets without re-encoding.
+    std::optional<std::string> concat_video_files(
+        const std::vector<std::filesystem::path>& inputs,
+        const std::filesystem::path& output
+    );
+
+
+    // Encodes packed YUV VideoFrames with libavcodec directly, from planar YUV 4:2:0.
+    class FFmpegWriter
+    {
+    public:
+
+        FFmpegWriter();
+
+        ~FFmpegWriter();
+
+        FFmpegWriter(const FFmpegWriter&) = delete;
+
+        FFmpegWriter& operator=(const FFmpegWriter&) = delete;
+
+
+        // The codec is chosen from the fourcc if given, then the fallback, then the container default.
+        std::optional<std::string> open(
+            const std::filesystem::path& path,
+            const cv::Size& resolution,
+            const double framerate,
+            const std::optional<int>& fourcc = std::nullopt,
+            const AVCodecID fallback_codec = AV_CODEC_ID_NONE
+        );
+
+        void write(const lvk::Frame& frame);
+
+        void close();
+
+        bool is_open() const;
+
+    private:
+
+        void encode(const AVFrame* frame);
+
+    private:
+        AVFormatContext* m_Format = nullptr;
+        AVCodecContext* m_Encoder = nullptr;
+        AVStream* m_Stream = nullptr;
+        AVPacket* m_Packet = nullptr;
+        AVFrame *m_Frame = nullptr, *m_SourceFrame = nullptr;
+        SwsContext* m_Converter = nullptr;
+        int64_t m_FrameIndex = 0;
+        bool m_HeaderWritten = false;
+
+        cv::Size m_Resolution, m_ChromaSize;
+        lvk::VideoFrame m_YUVFrame;
+        std::vector<cv::UMat> m_Planes;
+        cv::UMat m_USubPlane, m_VSubPlane;
+    };
+
+}
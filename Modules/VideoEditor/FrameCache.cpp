@@ -0,0 +1,381 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "FrameCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr char FRAME_CACHE_MAGIC[8] = {'L', 'V', 'K', 'C', 'A', 'C', 'H', 'E'};
+    constexpr uint32_t FRAME_CACHE_VERSION = 1;
+
+    // Frames start on page boundaries so that each maps onto whole pages.
+    constexpr size_t FRAME_ALIGNMENT = 4096;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    struct FrameCacheHeader
+    {
+        char magic[8];
+        uint32_t version;
+        int32_t codec;
+        uint64_t source_key;
+
+        int32_t width, height, type, format;
+        double framerate;
+
+        uint64_t frame_count, frame_stride;
+        uint64_t data_offset, timestamp_offset;
+    };
+
+    static_assert(sizeof(FrameCacheHeader) <= FRAME_ALIGNMENT);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t frame_cache_key(const std::filesystem::path& input)
+    {
+        std::error_code fs_error;
+        const auto path = std::filesystem::absolute(input, fs_error).string();
+        const auto size = std::filesystem::file_size(input, fs_error);
+        const auto modified = std::filesystem::last_write_time(input, fs_error).time_since_epoch().count();
+
+        // FNV-1a, which is plenty to tell inputs apart.
+        uint64_t hash = 0xcbf29ce484222325;
+        const auto combine = [&](const void* data, const size_t length){
+            for(size_t i = 0; i < length; i++)
+            {
+                hash ^= static_cast<const uint8_t*>(data)[i];
+                hash *= 0x100000001b3;
+            }
+        };
+
+        combine(path.data(), path.size());
+        combine(&size, sizeof(size));
+        combine(&modified, sizeof(modified));
+
+        return hash;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    FrameCacheWriter::~FrameCacheWriter()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> FrameCacheWriter::open(
+        const std::filesystem::path& path,
+        const uint64_t source_key,
+        const double framerate,
+        const int codec
+    )
+    {
+        close();
+
+        m_Path = path;
+        m_TempPath = path.string() + ".tmp";
+        m_File = std::fopen(m_TempPath.string().c_str(), "wb");
+        if(m_File == nullptr)
+            return cv::format("Failed to create the frame cache \'%s\'", m_TempPath.string().c_str());
+
+        // Reserve space for the header, which is only complete once all frames are known.
+        const std::vector<char> header_space(FRAME_ALIGNMENT, 0);
+        if(std::fwrite(header_space.data(), 1, header_space.size(), m_File) != header_space.size())
+        {
+            close();
+            return cv::format("Failed to write the frame cache \'%s\'", m_TempPath.string().c_str());
+        }
+
+        m_SourceKey = source_key;
+        m_Framerate = framerate;
+        m_Codec = codec;
+        m_Type = m_Format = -1;
+        m_Timestamps.clear();
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FrameCacheWriter::write(const lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+
+        // The cache holds frames of a single layout, which the first frame decides.
+        if(m_Timestamps.empty())
+        {
+            m_Resolution = frame.size();
+            m_Type = frame.type();
+            m_Format = static_cast<int>(frame.format);
+
+            const size_t frame_bytes = frame.total() * frame.elemSize();
+            m_FrameStride = ((frame_bytes + FRAME_ALIGNMENT - 1) / FRAME_ALIGNMENT) * FRAME_ALIGNMENT;
+        }
+        else if(frame.size() != m_Resolution || frame.type() != m_Type || static_cast<int>(frame.format) != m_Format)
+            return false;
+
+        frame.copyTo(m_HostFrame);
+        if(!m_HostFrame.isContinuous())
+            m_HostFrame = m_HostFrame.clone();
+
+        const size_t frame_bytes = m_HostFrame.total() * m_HostFrame.elemSize();
+        if(std::fwrite(m_HostFrame.data, 1, frame_bytes, m_File) != frame_bytes)
+            return false;
+
+        // Pad the frame out to its stride, keeping the next frame page aligned.
+        if(std::fseek(m_File, static_cast<long>(m_FrameStride - frame_bytes), SEEK_CUR) != 0)
+            return false;
+
+        m_Timestamps.push_back(frame.timestamp);
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> FrameCacheWriter::finish()
+    {
+        LVK_ASSERT(is_open());
+
+        FrameCacheHeader header = {};
+        std::memcpy(header.magic, FRAME_CACHE_MAGIC, sizeof(header.magic));
+        header.version = FRAME_CACHE_VERSION;
+        header.codec = m_Codec;
+        header.source_key = m_SourceKey;
+        header.width = m_Resolution.width;
+        header.height = m_Resolution.height;
+        header.type = m_Type;
+        header.format = m_Format;
+        header.framerate = m_Framerate;
+        header.frame_count = m_Timestamps.size();
+        header.frame_stride = m_FrameStride;
+        header.data_offset = FRAME_ALIGNMENT;
+        header.timestamp_offset = header.data_offset + header.frame_count * header.frame_stride;
+
+        // The timestamps follow the frames, then the header is filled in at the front.
+        const bool written = std::fseek(m_File, static_cast<long>(header.timestamp_offset), SEEK_SET) == 0
+            && std::fwrite(m_Timestamps.data(), sizeof(uint64_t), m_Timestamps.size(), m_File) == m_Timestamps.size()
+            && std::fseek(m_File, 0, SEEK_SET) == 0
+            && std::fwrite(&header, sizeof(header), 1, m_File) == 1
+            && std::fclose(m_File) == 0;
+        m_File = nullptr;
+
+        std::error_code fs_error;
+        if(written)
+            std::filesystem::rename(m_TempPath, m_Path, fs_error);
+
+        if(!written || fs_error)
+        {
+            close();
+            return cv::format("Failed to finish the frame cache \'%s\'", m_Path.string().c_str());
+        }
+
+        m_Path.clear();
+        m_TempPath.clear();
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameCacheWriter::close()
+    {
+        if(m_File != nullptr)
+        {
+            std::fclose(m_File);
+            m_File = nullptr;
+        }
+
+        if(!m_TempPath.empty())
+        {
+            std::error_code fs_error;
+            std::filesystem::remove(m_TempPath, fs_error);
+            m_TempPath.clear();
+        }
+
+        m_Timestamps.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FrameCacheWriter::is_open() const
+    {
+        return m_File != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    FrameCacheReader::~FrameCacheReader()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> FrameCacheReader::open(const std::filesystem::path& path, const uint64_t source_key)
+    {
+        close();
+
+#ifndef WIN32
+        const int file = ::open(path.c_str(), O_RDONLY);
+        if(file < 0)
+            return cv::format("No frame cache exists at \'%s\'", path.string().c_str());
+
+        struct stat file_info = {};
+        void* mapping = MAP_FAILED;
+        if(::fstat(file, &file_info) == 0 && static_cast<size_t>(file_info.st_size) >= sizeof(FrameCacheHeader))
+            mapping = ::mmap(nullptr, file_info.st_size, PROT_READ, MAP_SHARED, file, 0);
+        ::close(file);
+
+        if(mapping == MAP_FAILED)
+            return cv::format("Failed to map the frame cache \'%s\'", path.string().c_str());
+
+        m_Mapping = static_cast<const uint8_t*>(mapping);
+        m_MappingSize = static_cast<size_t>(file_info.st_size);
+
+        FrameCacheHeader header;
+        std::memcpy(&header, m_Mapping, sizeof(header));
+
+        const bool valid = std::memcmp(header.magic, FRAME_CACHE_MAGIC, sizeof(header.magic)) == 0
+            && header.version == FRAME_CACHE_VERSION
+            && header.timestamp_offset + header.frame_count * sizeof(uint64_t) <= m_MappingSize;
+
+        if(!valid || header.source_key != source_key)
+        {
+            close();
+            return cv::format("The frame cache \'%s\' is invalid or out of date", path.string().c_str());
+        }
+
+        m_Resolution = cv::Size(header.width, header.height);
+        m_Type = header.type;
+        m_Format = static_cast<lvk::VideoFrame::Format>(header.format);
+        m_Framerate = header.framerate;
+        m_Codec = header.codec;
+
+        m_FrameData = m_Mapping + header.data_offset;
+        m_Timestamps = reinterpret_cast<const uint64_t*>(m_Mapping + header.timestamp_offset);
+        m_FrameStride = header.frame_stride;
+        m_FrameCount = header.frame_count;
+        m_FramesRead = 0;
+
+        // Frames are read front to back, so let the kernel read well ahead of us.
+        ::madvise(mapping, m_MappingSize, MADV_SEQUENTIAL);
+
+        return std::nullopt;
+#else
+        return "Frame caches are not supported on Windows";
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FrameCacheReader::read(lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+
+        const uint64_t index = m_FramesRead;
+        if(index >= m_FrameCount)
+            return false;
+
+        // Upload straight from the mapping, the page cache is the only copy on the host.
+        const cv::Mat frame_view(m_Resolution, m_Type, const_cast<uint8_t*>(m_FrameData + index * m_FrameStride));
+        frame_view.copyTo(frame);
+        frame.format = m_Format;
+        frame.timestamp = m_Timestamps[index];
+
+        m_FramesRead++;
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FrameCacheReader::seek(const lvk::Time& position)
+    {
+        LVK_ASSERT(is_open());
+
+        // Every frame is available, so seeking is exact.
+        const auto target = static_cast<uint64_t>(position.nanoseconds());
+        m_FramesRead = static_cast<uint64_t>(
+            std::lower_bound(m_Timestamps, m_Timestamps + m_FrameCount, target) - m_Timestamps
+        );
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameCacheReader::close()
+    {
+#ifndef WIN32
+        if(m_Mapping != nullptr)
+            ::munmap(const_cast<uint8_t*>(m_Mapping), m_MappingSize);
+#endif
+        m_Mapping = nullptr;
+        m_MappingSize = 0;
+        m_FrameCount = 0;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FrameCacheReader::is_open() const
+    {
+        return m_Mapping != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double FrameCacheReader::framerate() const
+    {
+        return m_Framerate;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    int FrameCacheReader::codec() const
+    {
+        return m_Codec;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t FrameCacheReader::frame_count() const
+    {
+        return m_FrameCount;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t FrameCacheReader::frames_read() const
+    {
+        return m_FramesRead;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
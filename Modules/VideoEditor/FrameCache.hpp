@@ -0,0 +1,133 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <filesystem>
+#include <optional>
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+namespace clt
+{
+
+    // Identifies the input a cache was built from, by its path, size and modification time.
+    uint64_t frame_cache_key(const std::filesystem::path& input);
+
+
+    // Stores decoded frames uncompressed in a cache file, along with their format and timestamps.
+    // Frames are written to a temporary file, which only replaces the cache once it is finished.
+    class FrameCacheWriter
+    {
+    public:
+
+        FrameCacheWriter() = default;
+
+        ~FrameCacheWriter();
+
+        FrameCacheWriter(const FrameCacheWriter&) = delete;
+
+        FrameCacheWriter& operator=(const FrameCacheWriter&) = delete;
+
+
+        std::optional<std::string> open(
+            const std::filesystem::path& path,
+            const uint64_t source_key,
+            const double framerate,
+            const int codec
+        );
+
+        bool write(const lvk::Frame& frame);
+
+        std::optional<std::string> finish();
+
+        // Discards the cache unless it was finished.
+        void close();
+
+        bool is_open() const;
+
+    private:
+        std::filesystem::path m_Path, m_TempPath;
+        FILE* m_File = nullptr;
+
+        uint64_t m_SourceKey = 0;
+        double m_Framerate = 0.0;
+        int m_Codec = 0;
+
+        cv::Size m_Resolution;
+        int m_Type = -1, m_Format = -1;
+        size_t m_FrameStride = 0;
+
+        cv::Mat m_HostFrame;
+        std::vector<uint64_t> m_Timestamps;
+    };
+
+
+    // Reads frames from a finished cache through a read-only mapping, avoiding any decoding.
+    class FrameCacheReader
+    {
+    public:
+
+        FrameCacheReader() = default;
+
+        ~FrameCacheReader();
+
+        FrameCacheReader(const FrameCacheReader&) = delete;
+
+        FrameCacheReader& operator=(const FrameCacheReader&) = delete;
+
+
+        // Fails if the cache is missing, or was not built from the given source.
+        std::optional<std::string> open(const std::filesystem::path& path, const uint64_t source_key);
+
+        bool read(lvk::Frame& frame);
+
+        bool seek(const lvk::Time& position);
+
+        void close();
+
+
+        bool is_open() const;
+
+        double framerate() const;
+
+        int codec() const;
+
+        uint64_t frame_count() const;
+
+        uint64_t frames_read() const;
+
+    private:
+        const uint8_t* m_Mapping = nullptr;
+        size_t m_MappingSize = 0;
+
+        cv::Size m_Resolution;
+        int m_Type = -1;
+        lvk::VideoFrame::Format m_Format = lvk::VideoFrame::UNKNOWN;
+        double m_Framerate = 0.0;
+        int m_Codec = 0;
+
+        const uint8_t* m_FrameData = nullptr;
+        const uint64_t* m_Timestamps = nullptr;
+        size_t m_FrameStride = 0;
+        uint64_t m_FrameCount = 0;
+        std::atomic<uint64_t> m_FramesRead = 0;
+    };
+
+}
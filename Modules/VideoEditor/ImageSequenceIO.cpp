@@ -0,0 +1,479 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "ImageSequenceIO.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <regex>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::vector<std::string> IMAGE_EXTENSIONS = {
+        ".png", ".jpg", ".jpeg", ".exr", ".tif", ".tiff", ".bmp", ".webp"
+    };
+
+    // OpenCV decodes these from memory directly, the rest go through a temporary file.
+    const std::vector<std::string> MEMORY_DECODABLE_EXTENSIONS = {
+        ".png", ".jpg", ".jpeg", ".bmp", ".webp"
+    };
+
+    const std::regex FRAME_NUMBER_SPECIFIER("%0?[0-9]*d");
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool has_extension(const std::filesystem::path& path, const std::vector<std::string>& extensions)
+    {
+        auto extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        return std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool is_image_sequence(const std::filesystem::path& path)
+    {
+        const auto filename = path.filename().string();
+        const bool numbered = std::regex_search(filename, FRAME_NUMBER_SPECIFIER);
+        const bool globbed = filename.find_first_of("*?") != std::string::npos;
+
+        return (numbered || globbed) && has_extension(path, IMAGE_EXTENSIONS);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<std::filesystem::path> list_sequence_files(const std::filesystem::path& pattern)
+    {
+        std::vector<std::filesystem::path> files;
+
+        const auto filename = pattern.filename().string();
+        if(filename.find_first_of("*?") != std::string::npos)
+        {
+            std::vector<cv::String> matches;
+            cv::glob(pattern.string(), matches, false);
+            std::sort(matches.begin(), matches.end());
+
+            files.assign(matches.begin(), matches.end());
+            return files;
+        }
+
+        // Match every file against the printf pattern, ordering them by their frame number. The
+        // trailing %n ensures that the whole filename was matched, not just a prefix of it.
+        const auto scan_pattern = std::regex_replace(filename, FRAME_NUMBER_SPECIFIER, "%d") + "%n";
+        const auto directory = pattern.has_parent_path() ? pattern.parent_path() : std::filesystem::path(".");
+
+        std::vector<std::pair<int, std::filesystem::path>> frames;
+        std::error_code fs_error;
+        for(const auto& entry : std::filesystem::directory_iterator(directory, fs_error))
+        {
+            const auto name = entry.path().filename().string();
+
+            int frame_number = 0, matched_length = 0;
+            if(std::sscanf(name.c_str(), scan_pattern.c_str(), &frame_number, &matched_length) == 1
+                && static_cast<size_t>(matched_length) == name.length())
+                frames.emplace_back(frame_number, entry.path());
+        }
+        std::sort(frames.begin(), frames.end());
+
+        for(auto& [frame_number, path] : frames)
+            files.push_back(std::move(path));
+
+        return files;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Mat decode_image(const std::filesystem::path& path)
+    {
+#ifndef WIN32
+        // Map the file straight into the decoder's input, avoiding a copy through a read buffer.
+        if(has_extension(path, MEMORY_DECODABLE_EXTENSIONS))
+        {
+            const int file = ::open(path.c_str(), O_RDONLY);
+            if(file >= 0)
+            {
+                struct stat file_info = {};
+                void* data = MAP_FAILED;
+                if(::fstat(file, &file_info) == 0 && file_info.st_size > 0)
+                    data = ::mmap(nullptr, file_info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+                ::close(file);
+
+                if(data != MAP_FAILED)
+                {
+                    ::madvise(data, file_info.st_size, MADV_SEQUENTIAL);
+
+                    const cv::Mat buffer(1, static_cast<int>(file_info.st_size), CV_8UC1, data);
+                    cv::Mat image = cv::imdecode(buffer, cv::IMREAD_COLOR);
+
+                    ::munmap(data, file_info.st_size);
+                    return image;
+                }
+            }
+        }
+#endif
+        return cv::imread(path.string(), cv::IMREAD_COLOR);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    ImageSequenceReader::~ImageSequenceReader()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> ImageSequenceReader::open(
+        const std::filesystem::path& pattern,
+        const double framerate,
+        const uint32_t threads,
+        const uint32_t read_ahead
+    )
+    {
+        LVK_ASSERT(framerate > 0);
+        LVK_ASSERT(threads >= 1);
+        LVK_ASSERT(read_ahead >= 1);
+
+        close();
+
+        m_Files = list_sequence_files(pattern);
+        if(m_Files.empty())
+            return cv::format("No images were found matching \'%s\'", pattern.string().c_str());
+
+        m_Framerate = framerate;
+        m_ReadAhead = std::max(read_ahead, threads);
+        m_NextDecode = 0;
+        m_NextRead = 0;
+        m_FramesRead = 0;
+        m_Stopping = false;
+        m_Error.reset();
+
+        for(uint32_t i = 0; i < threads; i++)
+            m_Decoders.emplace_back(&ImageSequenceReader::run_decoder, this);
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ImageSequenceReader::run_decoder()
+    {
+        while(true)
+        {
+            // Claim the next image, staying within the read-ahead of the reader.
+            uint64_t index = 0, generation = 0;
+            {
+                std::unique_lock lock(m_Mutex);
+                m_Updated.wait(lock, [&](){
+                    return m_Stopping || (m_NextDecode < m_Files.size() && m_NextDecode < m_NextRead + m_ReadAhead);
+                });
+
+                if(m_Stopping)
+                    return;
+
+                index = m_NextDecode++;
+                generation = m_Generation;
+            }
+
+            cv::Mat image = decode_image(m_Files[index]);
+
+            // Results from before a seek are no longer wanted.
+            std::scoped_lock lock(m_Mutex);
+            if(generation == m_Generation)
+            {
+                m_Decoded.emplace(index, std::move(image));
+                m_Updated.notify_all();
+            }
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool ImageSequenceReader::read(lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+
+        cv::Mat image;
+        {
+            std::unique_lock lock(m_Mutex);
+            if(m_NextRead >= m_Files.size() || m_Error.has_value())
+                return false;
+
+            m_Updated.wait(lock, [&](){
+                return m_Stopping || m_Decoded.count(m_NextRead) > 0;
+            });
+
+            if(m_Stopping)
+                return false;
+
+            auto entry = m_Decoded.find(m_NextRead);
+            image = std::move(entry->second);
+            m_Decoded.erase(entry);
+
+            // Failures end the stream, as a missing frame would silently corrupt the output.
+            if(image.empty())
+            {
+                m_Error = cv::format("Failed to decode image \'%s\'", m_Files[m_NextRead].string().c_str());
+                return false;
+            }
+
+            m_NextRead++;
+            m_Updated.notify_all();
+        }
+
+        image.copyTo(frame);
+        frame.format = lvk::VideoFrame::BGR;
+        frame.timestamp = static_cast<uint64_t>(
+            (lvk::Time::Timestep(m_Framerate) * static_cast<double>(m_FramesRead++)).nanoseconds()
+        );
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool ImageSequenceReader::seek(const lvk::Time& position)
+    {
+        LVK_ASSERT(is_open());
+
+        // Every frame is a keyframe, so seeking is exact.
+        const auto index = static_cast<uint64_t>(std::round(position.seconds() * m_Framerate));
+
+        std::scoped_lock lock(m_Mutex);
+        m_Generation++;
+        m_Decoded.clear();
+        m_NextDecode = m_NextRead = std::min<uint64_t>(index, m_Files.size());
+        m_FramesRead = m_NextRead;
+        m_Updated.notify_all();
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ImageSequenceReader::close()
+    {
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_Stopping = true;
+            m_Updated.notify_all();
+        }
+
+        for(auto& decoder : m_Decoders)
+            if(decoder.joinable())
+                decoder.join();
+
+        m_Decoders.clear();
+        m_Decoded.clear();
+        m_Files.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool ImageSequenceReader::is_open() const
+    {
+        return !m_Files.empty();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double ImageSequenceReader::framerate() const
+    {
+        return m_Framerate;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t ImageSequenceReader::frame_count() const
+    {
+        return m_Files.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t ImageSequenceReader::frames_read() const
+    {
+        return m_FramesRead;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::optional<std::string>& ImageSequenceReader::error() const
+    {
+        return m_Error;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    ImageSequenceWriter::~ImageSequenceWriter()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> ImageSequenceWriter::open(
+        const std::filesystem::path& pattern,
+        const uint32_t threads,
+        const uint32_t queue_capacity
+    )
+    {
+        LVK_ASSERT(threads >= 1);
+        LVK_ASSERT(queue_capacity >= 1);
+
+        close();
+
+        const auto filename = pattern.filename().string();
+        if(!std::regex_search(filename, FRAME_NUMBER_SPECIFIER) || !has_extension(pattern, IMAGE_EXTENSIONS))
+        {
+            return cv::format(
+                "Invalid image sequence output \'%s\', expected a numbered pattern such as \'frames/%%04d.png\'",
+                pattern.string().c_str()
+            );
+        }
+
+        if(pattern.has_parent_path())
+        {
+            std::error_code fs_error;
+            std::filesystem::create_directories(pattern.parent_path(), fs_error);
+        }
+
+        m_Pattern = pattern.string();
+        m_QueueCapacity = std::max(queue_capacity, threads);
+        m_FrameIndex = 0;
+        m_Finishing = false;
+        m_Error.reset();
+
+        for(uint32_t i = 0; i < threads; i++)
+            m_Encoders.emplace_back(&ImageSequenceWriter::run_encoder, this);
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ImageSequenceWriter::write(const lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+
+        // Download the frame here, so the encoders never touch the GPU.
+        cv::Mat image;
+        if(frame.format != lvk::VideoFrame::BGR && frame.format != lvk::VideoFrame::UNKNOWN)
+        {
+            frame.reformatTo(m_BGRFrame, lvk::VideoFrame::BGR);
+            m_BGRFrame.copyTo(image);
+        }
+        else frame.copyTo(image);
+
+        std::unique_lock lock(m_Mutex);
+        m_SpaceAvailable.wait(lock, [&](){
+            return m_Queue.size() < m_QueueCapacity || m_Error.has_value();
+        });
+
+        if(m_Error.has_value())
+            throw std::runtime_error(*m_Error);
+
+        m_Queue.emplace_back(m_FrameIndex++, std::move(image));
+        m_FrameAvailable.notify_one();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ImageSequenceWriter::run_encoder()
+    {
+        while(true)
+        {
+            std::pair<uint64_t, cv::Mat> job;
+            {
+                std::unique_lock lock(m_Mutex);
+                m_FrameAvailable.wait(lock, [&](){
+                    return !m_Queue.empty() || m_Finishing;
+                });
+
+                if(m_Queue.empty())
+                    return;
+
+                job = std::move(m_Queue.front());
+                m_Queue.pop_front();
+                m_SpaceAvailable.notify_one();
+            }
+
+            // Every frame has its own file, so the encoders need no ordering between them.
+            const auto path = cv::format(m_Pattern.c_str(), static_cast<int>(job.first));
+
+            bool written = false;
+            try
+            {
+                written = cv::imwrite(path, job.second);
+            }
+            catch(const cv::Exception&) {}
+
+            if(!written)
+            {
+                std::scoped_lock lock(m_Mutex);
+                if(!m_Error.has_value())
+                    m_Error = cv::format("Failed to write image \'%s\'", path.c_str());
+                m_SpaceAvailable.notify_all();
+            }
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ImageSequenceWriter::close()
+    {
+        // Let the encoders drain the queue before they exit.
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_Finishing = true;
+            m_FrameAvailable.notify_all();
+        }
+
+        for(auto& encoder : m_Encoders)
+            if(encoder.joinable())
+                encoder.join();
+
+        m_Encoders.clear();
+        m_Queue.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool ImageSequenceWriter::is_open() const
+    {
+        return !m_Encoders.empty();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::optional<std::string>& ImageSequenceWriter::error() const
+    {
+        return m_Error;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,146 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <condition_variable>
+#include <filesystem>
+#include <optional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <map>
+
+namespace clt
+{
+
+    // Returns whether the path names an image sequence, either as a printf pattern such as
+    // 'frames/%04d.png', or for inputs, as a glob such as 'frames/*.exr'.
+    bool is_image_sequence(const std::filesystem::path& path);
+
+
+    // Decodes an image sequence on a pool of threads, reading ahead of the caller while still
+    // delivering frames in order. Codecs which can decode from memory are read via mmap.
+    class ImageSequenceReader
+    {
+    public:
+
+        ImageSequenceReader() = default;
+
+        ~ImageSequenceReader();
+
+        ImageSequenceReader(const ImageSequenceReader&) = delete;
+
+        ImageSequenceReader& operator=(const ImageSequenceReader&) = delete;
+
+
+        std::optional<std::string> open(
+            const std::filesystem::path& pattern,
+            const double framerate,
+            const uint32_t threads,
+            const uint32_t read_ahead
+        );
+
+        bool read(lvk::Frame& frame);
+
+        bool seek(const lvk::Time& position);
+
+        void close();
+
+
+        bool is_open() const;
+
+        double framerate() const;
+
+        uint64_t frame_count() const;
+
+        uint64_t frames_read() const;
+
+        const std::optional<std::string>& error() const;
+
+    private:
+
+        void run_decoder();
+
+    private:
+        std::vector<std::filesystem::path> m_Files;
+        std::vector<std::thread> m_Decoders;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Updated;
+        std::map<uint64_t, cv::Mat> m_Decoded;
+        uint64_t m_NextDecode = 0, m_NextRead = 0, m_Generation = 0;
+        uint32_t m_ReadAhead = 1;
+        bool m_Stopping = false;
+
+        double m_Framerate = 30.0;
+        std::atomic<uint64_t> m_FramesRead = 0;
+        std::optional<std::string> m_Error;
+    };
+
+
+    // Encodes frames to a numbered image sequence on a pool of threads, writing behind the caller.
+    class ImageSequenceWriter
+    {
+    public:
+
+        ImageSequenceWriter() = default;
+
+        ~ImageSequenceWriter();
+
+        ImageSequenceWriter(const ImageSequenceWriter&) = delete;
+
+        ImageSequenceWriter& operator=(const ImageSequenceWriter&) = delete;
+
+
+        std::optional<std::string> open(
+            const std::filesystem::path& pattern,
+            const uint32_t threads,
+            const uint32_t queue_capacity
+        );
+
+        void write(const lvk::Frame& frame);
+
+        void close();
+
+
+        bool is_open() const;
+
+        const std::optional<std::string>& error() const;
+
+    private:
+
+        void run_encoder();
+
+    private:
+        std::string m_Pattern;
+        std::vector<std::thread> m_Encoders;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_FrameAvailable, m_SpaceAvailable;
+        std::deque<std::pair<uint64_t, cv::Mat>> m_Queue;
+        uint32_t m_QueueCapacity = 1;
+        bool m_Finishing = false;
+
+        uint64_t m_FrameIndex = 0;
+        lvk::VideoFrame m_BGRFrame;
+        std::optional<std::string> m_Error;
+    };
+
+}
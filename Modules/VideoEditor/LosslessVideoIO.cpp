@@ -0,0 +1,730 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "LosslessVideoIO.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <thread>
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr char LOSSLESS_FILE_MAGIC[4] = {'L', 'V', 'K', 'V'};
+    constexpr char LOSSLESS_INDEX_MAGIC[4] = {'L', 'V', 'K', 'I'};
+    constexpr uint32_t LOSSLESS_VERSION = 1;
+
+    // Slices shorter than this compress poorly and cost more to schedule than they save.
+    constexpr int MIN_SLICE_ROWS = 16;
+    constexpr uint32_t MAX_SLICES = 256;
+
+    // QOI operations, see https://qoiformat.org/qoi-specification.pdf
+    constexpr uint8_t OP_INDEX = 0x00;
+    constexpr uint8_t OP_DIFF  = 0x40;
+    constexpr uint8_t OP_LUMA  = 0x80;
+    constexpr uint8_t OP_RUN   = 0xc0;
+    constexpr uint8_t OP_RGB   = 0xfe;
+    constexpr uint8_t OP_RGBA  = 0xff;
+    constexpr uint8_t OP_MASK  = 0xc0;
+    constexpr int MAX_RUN = 62;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t version;
+        int32_t width, height, type, format;
+        double framerate;
+        uint32_t slice_count, reserved;
+    };
+
+    // Each frame is its timestamp and slice sizes, followed by the slice data.
+    struct FrameHeader
+    {
+        uint64_t timestamp;
+    };
+
+    // The index is a list of frame offsets and timestamps, ending with this trailer.
+    struct IndexTrailer
+    {
+        uint64_t index_offset, frame_count;
+        char magic[4];
+        uint32_t reserved;
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool seek_file(FILE* file, const int64_t offset, const int origin = SEEK_SET)
+    {
+#ifdef WIN32
+        return _fseeki64(file, offset, origin) == 0;
+#else
+        return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t tell_file(FILE* file)
+    {
+#ifdef WIN32
+        return static_cast<uint64_t>(_ftelli64(file));
+#else
+        return static_cast<uint64_t>(ftello(file));
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Frames of fewer than four channels are treated as opaque, with grayscale spread across RGB.
+    struct Pixel
+    {
+        uint8_t r = 0, g = 0, b = 0, a = 255;
+
+        bool operator==(const Pixel& other) const
+        {
+            return r == other.r && g == other.g && b == other.b && a == other.a;
+        }
+
+        int hash() const
+        {
+            return (r * 3 + g * 5 + b * 7 + a * 11) % 64;
+        }
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<int C>
+    Pixel load_pixel(const uint8_t* data)
+    {
+        if constexpr(C == 1) return {data[0], data[0], data[0], 255};
+        else if constexpr(C == 3) return {data[0], data[1], data[2], 255};
+        else return {data[0], data[1], data[2], data[3]};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<int C>
+    void store_pixel(const Pixel& pixel, uint8_t* data)
+    {
+        data[0] = pixel.r;
+        if constexpr(C >= 3)
+        {
+            data[1] = pixel.g;
+            data[2] = pixel.b;
+        }
+        if constexpr(C == 4)
+            data[3] = pixel.a;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t max_encoded_size(const cv::Mat& slice)
+    {
+        // A raw RGBA operation for every pixel is the worst case.
+        return slice.total() * 5;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<int C>
+    size_t encode_slice(const cv::Mat& slice, uint8_t* output)
+    {
+        Pixel index[64] = {}, previous;
+        size_t length = 0;
+        int run = 0;
+
+        for(int r = 0; r < slice.rows; r++)
+        {
+            const uint8_t* row = slice.ptr<uint8_t>(r);
+            for(int c = 0; c < slice.cols; c++)
+            {
+                const Pixel pixel = load_pixel<C>(row + c * C);
+
+                if(pixel == previous)
+                {
+                    if(++run == MAX_RUN)
+                    {
+                        output[length++] = OP_RUN | (run - 1);
+                        run = 0;
+                    }
+                    continue;
+                }
+
+                if(run > 0)
+                {
+                    output[length++] = OP_RUN | (run - 1);
+                    run = 0;
+                }
+
+                const int hash = pixel.hash();
+                if(index[hash] == pixel)
+                    output[length++] = OP_INDEX | hash;
+                else
+                {
+                    index[hash] = pixel;
+
+                    if(pixel.a == previous.a)
+                    {
+                        const auto dr = static_cast<int8_t>(pixel.r - previous.r);
+                        const auto dg = static_cast<int8_t>(pixel.g - previous.g);
+                        const auto db = static_cast<int8_t>(pixel.b - previous.b);
+                        const int dr_dg = dr - dg, db_dg = db - dg;
+
+                        if(dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2)
+                            output[length++] = OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2);
+                        else if(dg > -33 && dg < 32 && dr_dg > -9 && dr_dg < 8 && db_dg > -9 && db_dg < 8)
+                        {
+                            output[length++] = OP_LUMA | (dg + 32);
+                            output[length++] = (dr_dg + 8) << 4 | (db_dg + 8);
+                        }
+                        else
+                        {
+                            output[length++] = OP_RGB;
+                            output[length++] = pixel.r;
+                            output[length++] = pixel.g;
+                            output[length++] = pixel.b;
+                        }
+                    }
+                    else
+                    {
+                        output[length++] = OP_RGBA;
+                        output[length++] = pixel.r;
+                        output[length++] = pixel.g;
+                        output[length++] = pixel.b;
+                        output[length++] = pixel.a;
+                    }
+                }
+                previous = pixel;
+            }
+        }
+
+        if(run > 0)
+            output[length++] = OP_RUN | (run - 1);
+
+        return length;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<int C>
+    bool decode_slice(const uint8_t* input, const size_t length, cv::Mat& slice)
+    {
+        Pixel index[64] = {}, pixel;
+        size_t position = 0;
+        int run = 0;
+
+        for(int r = 0; r < slice.rows; r++)
+        {
+            uint8_t* row = slice.ptr<uint8_t>(r);
+            for(int c = 0; c < slice.cols; c++)
+            {
+                if(run > 0)
+                    run--;
+                else
+                {
+                    if(position >= length)
+                        return false;
+
+                    const uint8_t op = input[position++];
+                    if(op == OP_RGB || op == OP_RGBA)
+                    {
+                        const size_t operands = op == OP_RGB ? 3 : 4;
+                        if(position + operands > length)
+                            return false;
+
+                        pixel.r = input[position++];
+                        pixel.g = input[position++];
+                        pixel.b = input[position++];
+                        if(op == OP_RGBA)
+                            pixel.a = input[position++];
+                    }
+                    else if((op & OP_MASK) == OP_INDEX)
+                        pixel = index[op];
+                    else if((op & OP_MASK) == OP_DIFF)
+                    {
+                        pixel.r += ((op >> 4) & 0x03) - 2;
+                        pixel.g += ((op >> 2) & 0x03) - 2;
+                        pixel.b += (op & 0x03) - 2;
+                    }
+                    else if((op & OP_MASK) == OP_LUMA)
+                    {
+                        if(position >= length)
+                            return false;
+
+                        const uint8_t operand = input[position++];
+                        const int dg = (op & 0x3f) - 32;
+                        pixel.r += dg - 8 + ((operand >> 4) & 0x0f);
+                        pixel.g += dg;
+                        pixel.b += dg - 8 + (operand & 0x0f);
+                    }
+                    else run = op & 0x3f;
+
+                    index[pixel.hash()] = pixel;
+                }
+
+                store_pixel<C>(pixel, row + c * C);
+            }
+        }
+
+        return position == length;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Range slice_rows(const int rows, const uint32_t slice_count, const uint32_t slice)
+    {
+        const int slice_height = (rows + static_cast<int>(slice_count) - 1) / static_cast<int>(slice_count);
+        const int start = std::min(rows, static_cast<int>(slice) * slice_height);
+        return {start, std::min(rows, start + slice_height)};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool is_lossless_video(const std::filesystem::path& path)
+    {
+        return path.extension() == ".lvkv";
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> concat_lossless_videos(
+        const std::vector<std::filesystem::path>& inputs,
+        const std::filesystem::path& output
+    )
+    {
+        LosslessVideoWriter writer;
+        LosslessVideoReader reader;
+        lvk::Frame frame;
+
+        try
+        {
+            for(const auto& input : inputs)
+            {
+                if(auto error = reader.open(input); error.has_value())
+                    return error;
+
+                if(!writer.is_open())
+                {
+                    const auto error = writer.open(output, reader.resolution(), reader.framerate(), reader.slice_count());
+                    if(error.has_value())
+                        return error;
+                }
+
+                while(reader.read(frame))
+                    writer.write(frame);
+            }
+        }
+        catch(const std::exception& e)
+        {
+            return cv::format("Failed to join lossless videos into \'%s\' (%s)", output.string().c_str(), e.what());
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    LosslessVideoReader::~LosslessVideoReader()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> LosslessVideoReader::open(const std::filesystem::path& path)
+    {
+        close();
+
+        m_File = std::fopen(path.string().c_str(), "rb");
+        if(m_File == nullptr)
+            return cv::format("Failed to open the lossless video \'%s\'", path.string().c_str());
+
+        FileHeader header = {};
+        const bool valid = std::fread(&header, sizeof(header), 1, m_File) == 1
+            && std::memcmp(header.magic, LOSSLESS_FILE_MAGIC, sizeof(header.magic)) == 0
+            && header.version == LOSSLESS_VERSION
+            && header.width > 0 && header.height > 0
+            && CV_MAT_DEPTH(header.type) == CV_8U
+            && header.slice_count >= 1 && header.slice_count <= MAX_SLICES;
+
+        if(!valid)
+        {
+            close();
+            return cv::format("Invalid lossless video \'%s\'", path.string().c_str());
+        }
+
+        m_Resolution = cv::Size(header.width, header.height);
+        m_Type = header.type;
+        m_Format = static_cast<lvk::VideoFrame::Format>(header.format);
+        m_Framerate = header.framerate;
+        m_SliceCount = header.slice_count;
+        m_SliceSizes.resize(m_SliceCount);
+        m_HostFrame.create(m_Resolution, m_Type);
+        m_FramesRead = 0;
+
+        if(!load_index())
+            scan_index();
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LosslessVideoReader::load_index()
+    {
+        IndexTrailer trailer = {};
+        if(!seek_file(m_File, -static_cast<int64_t>(sizeof(trailer)), SEEK_END))
+            return false;
+
+        const uint64_t trailer_offset = tell_file(m_File);
+        if(std::fread(&trailer, sizeof(trailer), 1, m_File) != 1
+            || std::memcmp(trailer.magic, LOSSLESS_INDEX_MAGIC, sizeof(trailer.magic)) != 0
+            || trailer.index_offset + trailer.frame_count * sizeof(IndexEntry) != trailer_offset)
+            return false;
+
+        m_Index.resize(trailer.frame_count);
+        if(!seek_file(m_File, static_cast<int64_t>(trailer.index_offset))
+            || std::fread(m_Index.data(), sizeof(IndexEntry), m_Index.size(), m_File) != m_Index.size())
+        {
+            m_Index.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void LosslessVideoReader::scan_index()
+    {
+        // Without an index, step through the frames until the file runs out. Any frame which
+        // was only partially written before the file was abandoned is left out.
+        m_Index.clear();
+
+        seek_file(m_File, 0, SEEK_END);
+        const uint64_t file_size = tell_file(m_File);
+
+        uint64_t offset = sizeof(FileHeader);
+        while(seek_file(m_File, static_cast<int64_t>(offset)))
+        {
+            FrameHeader frame_header = {};
+            if(std::fread(&frame_header, sizeof(frame_header), 1, m_File) != 1
+                || std::fread(m_SliceSizes.data(), sizeof(uint32_t), m_SliceCount, m_File) != m_SliceCount)
+                break;
+
+            uint64_t frame_size = sizeof(FrameHeader) + m_SliceCount * sizeof(uint32_t);
+            for(const auto slice_size : m_SliceSizes)
+                frame_size += slice_size;
+
+            if(offset + frame_size > file_size)
+                break;
+
+            m_Index.push_back({offset, frame_header.timestamp});
+            offset += frame_size;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LosslessVideoReader::read(lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+
+        const uint64_t frame_index = m_FramesRead;
+        if(frame_index >= m_Index.size())
+            return false;
+
+        FrameHeader frame_header = {};
+        if(!seek_file(m_File, static_cast<int64_t>(m_Index[frame_index].offset))
+            || std::fread(&frame_header, sizeof(frame_header), 1, m_File) != 1
+            || std::fread(m_SliceSizes.data(), sizeof(uint32_t), m_SliceCount, m_File) != m_SliceCount)
+            return false;
+
+        size_t payload_size = 0;
+        for(const auto slice_size : m_SliceSizes)
+            payload_size += slice_size;
+
+        m_Payload.resize(payload_size);
+        if(std::fread(m_Payload.data(), 1, payload_size, m_File) != payload_size)
+            return false;
+
+        // Slices were coded independently, so are decoded in parallel straight into the host frame.
+        std::vector<size_t> slice_offsets(m_SliceCount, 0);
+        for(uint32_t i = 1; i < m_SliceCount; i++)
+            slice_offsets[i] = slice_offsets[i - 1] + m_SliceSizes[i - 1];
+
+        std::atomic<bool> corrupt = false;
+        cv::parallel_for_(cv::Range(0, static_cast<int>(m_SliceCount)), [&](const cv::Range& range){
+            for(int i = range.start; i < range.end; i++)
+            {
+                cv::Mat slice = m_HostFrame.rowRange(slice_rows(m_Resolution.height, m_SliceCount, i));
+                const uint8_t* data = m_Payload.data() + slice_offsets[i];
+
+                bool decoded = false;
+                switch(m_HostFrame.channels())
+                {
+                    case 1: decoded = decode_slice<1>(data, m_SliceSizes[i], slice); break;
+                    case 3: decoded = decode_slice<3>(data, m_SliceSizes[i], slice); break;
+                    case 4: decoded = decode_slice<4>(data, m_SliceSizes[i], slice); break;
+                    default: break;
+                }
+
+                if(!decoded)
+                    corrupt = true;
+            }
+        });
+
+        if(corrupt)
+            return false;
+
+        m_HostFrame.copyTo(frame);
+        frame.format = m_Format;
+        frame.timestamp = frame_header.timestamp;
+
+        m_FramesRead++;
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LosslessVideoReader::seek(const lvk::Time& position)
+    {
+        LVK_ASSERT(is_open());
+
+        // Every frame is independently coded, so seeking is exact.
+        const auto target = static_cast<uint64_t>(position.nanoseconds());
+        const auto entry = std::lower_bound(
+            m_Index.begin(), m_Index.end(), target,
+            [](const IndexEntry& entry, const uint64_t timestamp){
+                return entry.timestamp < timestamp;
+            }
+        );
+
+        m_FramesRead = static_cast<uint64_t>(std::distance(m_Index.begin(), entry));
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void LosslessVideoReader::close()
+    {
+        if(m_File != nullptr)
+        {
+            std::fclose(m_File);
+            m_File = nullptr;
+        }
+        m_Index.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LosslessVideoReader::is_open() const
+    {
+        return m_File != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const cv::Size& LosslessVideoReader::resolution() const
+    {
+        return m_Resolution;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double LosslessVideoReader::framerate() const
+    {
+        return m_Framerate;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint32_t LosslessVideoReader::slice_count() const
+    {
+        return m_SliceCount;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t LosslessVideoReader::frame_count() const
+    {
+        return m_Index.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t LosslessVideoReader::frames_read() const
+    {
+        return m_FramesRead;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    LosslessVideoWriter::~LosslessVideoWriter()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> LosslessVideoWriter::open(
+        const std::filesystem::path& path,
+        const cv::Size& resolution,
+        const double framerate,
+        const uint32_t slices
+    )
+    {
+        LVK_ASSERT(resolution.width > 0 && resolution.height > 0);
+        LVK_ASSERT(slices <= MAX_SLICES);
+
+        close();
+
+        m_File = std::fopen(path.string().c_str(), "wb");
+        if(m_File == nullptr)
+            return cv::format("Failed to create the lossless video \'%s\'", path.string().c_str());
+
+        const uint32_t hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        const uint32_t max_slices = static_cast<uint32_t>(std::max(resolution.height / MIN_SLICE_ROWS, 1));
+
+        m_Resolution = resolution;
+        m_Framerate = framerate;
+        m_SliceCount = std::min(slices > 0 ? slices : hardware_threads, max_slices);
+        m_SliceBuffers.resize(m_SliceCount);
+        m_SliceSizes.resize(m_SliceCount);
+        m_Type = -1;
+        m_Offsets.clear();
+        m_Timestamps.clear();
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void LosslessVideoWriter::write_header(const int type, const lvk::VideoFrame::Format format)
+    {
+        FileHeader header = {};
+        std::memcpy(header.magic, LOSSLESS_FILE_MAGIC, sizeof(header.magic));
+        header.version = LOSSLESS_VERSION;
+        header.width = m_Resolution.width;
+        header.height = m_Resolution.height;
+        header.type = type;
+        header.format = static_cast<int32_t>(format);
+        header.framerate = m_Framerate;
+        header.slice_count = m_SliceCount;
+
+        if(std::fwrite(&header, sizeof(header), 1, m_File) != 1)
+            throw std::runtime_error(cv::format("lossless video stream closed (%s)", std::strerror(errno)));
+
+        m_Type = type;
+        m_Format = format;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void LosslessVideoWriter::write(const lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+        LVK_ASSERT(frame.size() == m_Resolution);
+
+        // The file holds frames of a single layout, which the first frame decides.
+        if(m_Type < 0)
+        {
+            if(frame.depth() != CV_8U || (frame.channels() != 1 && frame.channels() != 3 && frame.channels() != 4))
+                throw std::runtime_error("lossless video only supports 8-bit frames of 1, 3 or 4 channels");
+
+            write_header(frame.type(), frame.format);
+        }
+        else if(frame.type() != m_Type || frame.format != m_Format)
+            throw std::runtime_error("lossless video frames must all share the same format");
+
+        frame.copyTo(m_HostFrame);
+
+        cv::parallel_for_(cv::Range(0, static_cast<int>(m_SliceCount)), [&](const cv::Range& range){
+            for(int i = range.start; i < range.end; i++)
+            {
+                const cv::Mat slice = m_HostFrame.rowRange(slice_rows(m_Resolution.height, m_SliceCount, i));
+
+                auto& buffer = m_SliceBuffers[i];
+                buffer.resize(max_encoded_size(slice));
+
+                switch(m_HostFrame.channels())
+                {
+                    case 1: m_SliceSizes[i] = static_cast<uint32_t>(encode_slice<1>(slice, buffer.data())); break;
+                    case 3: m_SliceSizes[i] = static_cast<uint32_t>(encode_slice<3>(slice, buffer.data())); break;
+                    case 4: m_SliceSizes[i] = static_cast<uint32_t>(encode_slice<4>(slice, buffer.data())); break;
+                    default: m_SliceSizes[i] = 0; break;
+                }
+            }
+        });
+
+        const uint64_t offset = tell_file(m_File);
+        const FrameHeader frame_header = {frame.timestamp};
+
+        bool written = std::fwrite(&frame_header, sizeof(frame_header), 1, m_File) == 1
+            && std::fwrite(m_SliceSizes.data(), sizeof(uint32_t), m_SliceCount, m_File) == m_SliceCount;
+
+        for(uint32_t i = 0; i < m_SliceCount && written; i++)
+            written = std::fwrite(m_SliceBuffers[i].data(), 1, m_SliceSizes[i], m_File) == m_SliceSizes[i];
+
+        if(!written)
+            throw std::runtime_error(cv::format("lossless video stream closed (%s)", std::strerror(errno)));
+
+        m_Offsets.push_back(offset);
+        m_Timestamps.push_back(frame.timestamp);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void LosslessVideoWriter::close()
+    {
+        if(m_File == nullptr)
+            return;
+
+        // Frames are only written once their layout is known, which an empty file never has.
+        if(m_Type >= 0)
+        {
+            IndexTrailer trailer = {};
+            trailer.index_offset = tell_file(m_File);
+            trailer.frame_count = m_Offsets.size();
+            std::memcpy(trailer.magic, LOSSLESS_INDEX_MAGIC, sizeof(trailer.magic));
+
+            for(size_t i = 0; i < m_Offsets.size(); i++)
+            {
+                const uint64_t entry[2] = {m_Offsets[i], m_Timestamps[i]};
+                std::fwrite(entry, sizeof(entry), 1, m_File);
+            }
+            std::fwrite(&trailer, sizeof(trailer), 1, m_File);
+        }
+
+        std::fclose(m_File);
+        m_File = nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LosslessVideoWriter::is_open() const
+    {
+        return m_File != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
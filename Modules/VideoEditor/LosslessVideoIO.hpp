@@ -0,0 +1,152 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <filesystem>
+#include <optional>
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+namespace clt
+{
+
+    // Returns whether the path names a lossless intermediate video, which use the '.lvkv' extension.
+    bool is_lossless_video(const std::filesystem::path& path);
+
+    // Joins lossless videos end to end, keeping the timestamps of each.
+    std::optional<std::string> concat_lossless_videos(
+        const std::vector<std::filesystem::path>& inputs,
+        const std::filesystem::path& output
+    );
+
+
+    // Reads lossless intermediate videos, which support exact random access through a frame index.
+    // Files that were never closed have their index rebuilt by scanning the frames.
+    class LosslessVideoReader
+    {
+    public:
+
+        LosslessVideoReader() = default;
+
+        ~LosslessVideoReader();
+
+        LosslessVideoReader(const LosslessVideoReader&) = delete;
+
+        LosslessVideoReader& operator=(const LosslessVideoReader&) = delete;
+
+
+        std::optional<std::string> open(const std::filesystem::path& path);
+
+        bool read(lvk::Frame& frame);
+
+        bool seek(const lvk::Time& position);
+
+        void close();
+
+
+        bool is_open() const;
+
+        const cv::Size& resolution() const;
+
+        double framerate() const;
+
+        uint32_t slice_count() const;
+
+        uint64_t frame_count() const;
+
+        uint64_t frames_read() const;
+
+    private:
+
+        bool load_index();
+
+        void scan_index();
+
+    private:
+        struct IndexEntry
+        {
+            uint64_t offset, timestamp;
+        };
+
+        FILE* m_File = nullptr;
+        cv::Size m_Resolution;
+        int m_Type = -1;
+        lvk::VideoFrame::Format m_Format = lvk::VideoFrame::UNKNOWN;
+        double m_Framerate = 0.0;
+        uint32_t m_SliceCount = 0;
+
+        std::vector<IndexEntry> m_Index;
+        std::atomic<uint64_t> m_FramesRead = 0;
+
+        std::vector<uint32_t> m_SliceSizes;
+        std::vector<uint8_t> m_Payload;
+        cv::Mat m_HostFrame;
+    };
+
+
+    // Writes 8-bit VideoFrames losslessly, compressing horizontal slices of each frame in
+    // parallel with a QOI-style predictor, and closing the file with a frame index.
+    class LosslessVideoWriter
+    {
+    public:
+
+        LosslessVideoWriter() = default;
+
+        ~LosslessVideoWriter();
+
+        LosslessVideoWriter(const LosslessVideoWriter&) = delete;
+
+        LosslessVideoWriter& operator=(const LosslessVideoWriter&) = delete;
+
+
+        // A slice count of zero picks one slice per hardware thread.
+        std::optional<std::string> open(
+            const std::filesystem::path& path,
+            const cv::Size& resolution,
+            const double framerate,
+            const uint32_t slices = 0
+        );
+
+        void write(const lvk::Frame& frame);
+
+        void close();
+
+        bool is_open() const;
+
+    private:
+
+        void write_header(const int type, const lvk::VideoFrame::Format format);
+
+    private:
+        FILE* m_File = nullptr;
+        cv::Size m_Resolution;
+        double m_Framerate = 0.0;
+        uint32_t m_SliceCount = 1;
+        int m_Type = -1;
+        lvk::VideoFrame::Format m_Format = lvk::VideoFrame::UNKNOWN;
+
+        std::vector<uint64_t> m_Offsets, m_Timestamps;
+
+        cv::Mat m_HostFrame;
+        std::vector<std::vector<uint8_t>> m_SliceBuffers;
+        std::vector<uint32_t> m_SliceSizes;
+    };
+
+}
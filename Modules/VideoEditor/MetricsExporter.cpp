@@ -0,0 +1,257 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "MetricsExporter.hpp"
+
+#include <opencv2/core.hpp>
+
+#ifdef WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#define close_socket closesocket
+#define poll_sockets WSAPoll
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <poll.h>
+#define close_socket close
+#define poll_sockets poll
+#endif
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr int ACCEPT_POLL_TIMEOUT_MS = 200;
+    constexpr int REQUEST_TIMEOUT_MS = 1000;
+    constexpr size_t MAX_REQUEST_SIZE = 8192;
+
+#ifdef MSG_NOSIGNAL
+    // Avoid SIGPIPE if the scraper disconnects early.
+    constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    constexpr int SEND_FLAGS = 0;
+#endif
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    MetricsExporter::~MetricsExporter()
+    {
+        stop();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> MetricsExporter::listen(const uint16_t port)
+    {
+        if(is_running())
+            return "Metrics exporter is already running";
+
+#ifdef WIN32
+        WSADATA wsa_data;
+        if(WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0)
+            return "Failed to initialize Winsock for the metrics exporter";
+#endif
+
+        m_Socket = static_cast<int>(socket(AF_INET, SOCK_STREAM, 0));
+        if(m_Socket < 0)
+            return "Failed to create metrics exporter socket";
+
+        const int reuse = 1;
+        setsockopt(m_Socket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+        // Only ever expose the metrics to the local machine.
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if(bind(m_Socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(m_Socket, 4) != 0)
+        {
+            close_socket(m_Socket);
+            m_Socket = -1;
+            return cv::format("Failed to bind metrics exporter to localhost port %u", port);
+        }
+
+        m_Running = true;
+        m_ServerThread = std::thread(&MetricsExporter::serve, this);
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> MetricsExporter::listen(const std::filesystem::path& socket_path)
+    {
+#ifdef WIN32
+        return "Unix socket metrics endpoints are not supported on Windows, use a port instead";
+#else
+        if(is_running())
+            return "Metrics exporter is already running";
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+
+        const auto path = socket_path.string();
+        if(path.size() >= sizeof(address.sun_path))
+            return cv::format("Metrics socket path \'%s\' is too long", path.c_str());
+        std::copy(path.begin(), path.end(), address.sun_path);
+
+        m_Socket = socket(AF_UNIX, SOCK_STREAM, 0);
+        if(m_Socket < 0)
+            return "Failed to create metrics exporter socket";
+
+        // Remove any stale socket left behind by a previous run.
+        std::error_code error;
+        if(std::filesystem::is_socket(socket_path, error))
+            std::filesystem::remove(socket_path, error);
+
+        if(bind(m_Socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(m_Socket, 4) != 0)
+        {
+            close_socket(m_Socket);
+            m_Socket = -1;
+            return cv::format("Failed to bind metrics exporter to socket \'%s\'", path.c_str());
+        }
+
+        m_SocketPath = socket_path;
+        m_Running = true;
+        m_ServerThread = std::thread(&MetricsExporter::serve, this);
+        return std::nullopt;
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MetricsExporter::publish(std::string metrics)
+    {
+        std::scoped_lock lock(m_MetricsMutex);
+        m_Metrics = std::move(metrics);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool MetricsExporter::is_running() const
+    {
+        return m_Running;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MetricsExporter::stop()
+    {
+        if(!m_Running.exchange(false))
+            return;
+
+        // The server polls the running flag, so will exit shortly.
+        if(m_ServerThread.joinable())
+            m_ServerThread.join();
+
+        close_socket(m_Socket);
+        m_Socket = -1;
+
+        if(m_SocketPath.has_value())
+        {
+            std::error_code error;
+            std::filesystem::remove(*m_SocketPath, error);
+            m_SocketPath.reset();
+        }
+
+#ifdef WIN32
+        WSACleanup();
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MetricsExporter::serve()
+    {
+        pollfd listener{};
+        listener.fd = m_Socket;
+        listener.events = POLLIN;
+
+        while(m_Running)
+        {
+            if(poll_sockets(&listener, 1, ACCEPT_POLL_TIMEOUT_MS) <= 0 || !(listener.revents & POLLIN))
+                continue;
+
+            const auto client = static_cast<int>(accept(m_Socket, nullptr, nullptr));
+            if(client < 0)
+                continue;
+
+            // Scrapes are infrequent and small, so they are answered one at a time.
+            respond(client);
+            close_socket(client);
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MetricsExporter::respond(const int client) const
+    {
+        // Read the request header, we only need the request line.
+        std::string request;
+        char buffer[1024];
+
+        pollfd connection{};
+        connection.fd = client;
+        connection.events = POLLIN;
+
+        while(request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_SIZE)
+        {
+            if(poll_sockets(&connection, 1, REQUEST_TIMEOUT_MS) <= 0)
+                return;
+
+            const auto received = recv(client, buffer, sizeof(buffer), 0);
+            if(received <= 0)
+                return;
+
+            request.append(buffer, static_cast<size_t>(received));
+        }
+
+        std::string status = "200 OK", body;
+        if(request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET / ", 0) == 0)
+        {
+            std::scoped_lock lock(m_MetricsMutex);
+            body = m_Metrics;
+        }
+        else
+        {
+            status = "404 Not Found";
+            body = "Metrics are served at /metrics\n";
+        }
+
+        const std::string response = "HTTP/1.1 " + status + "\r\n"
+                                     "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                     "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                                     "Connection: close\r\n\r\n" + body;
+
+        size_t sent = 0;
+        while(sent < response.size())
+        {
+            const auto result = send(client, response.data() + sent, static_cast<int>(response.size() - sent), SEND_FLAGS);
+            if(result <= 0) return;
+            sent += static_cast<size_t>(result);
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
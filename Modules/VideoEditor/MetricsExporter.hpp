@@ -0,0 +1,67 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <mutex>
+
+namespace clt
+{
+
+    // Serves the latest published metrics, in Prometheus text format, over HTTP on either
+    // a localhost port or a Unix domain socket. Requests are handled on a background thread
+    // so that a slow scraper can never stall the processing pipeline.
+    class MetricsExporter
+    {
+    public:
+
+        MetricsExporter() = default;
+
+        ~MetricsExporter();
+
+        std::optional<std::string> listen(const uint16_t port);
+
+        std::optional<std::string> listen(const std::filesystem::path& socket_path);
+
+        void publish(std::string metrics);
+
+        bool is_running() const;
+
+        void stop();
+
+    private:
+
+        void serve();
+
+        void respond(const int client) const;
+
+    private:
+        int m_Socket = -1;
+        std::thread m_ServerThread;
+        std::atomic<bool> m_Running = false;
+        std::optional<std::filesystem::path> m_SocketPath;
+
+        mutable std::mutex m_MetricsMutex;
+        std::string m_Metrics;
+    };
+
+}
@@ -0,0 +1,235 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "ParallelDecoder.hpp"
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    ParallelDecoder::~ParallelDecoder()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> ParallelDecoder::open(
+        const std::filesystem::path& path,
+        const uint32_t decoders,
+        const uint32_t chunk_frames,
+        const int decoder_threads
+    )
+    {
+        LVK_ASSERT(decoders >= 1);
+        LVK_ASSERT(chunk_frames >= 1);
+        LVK_ASSERT(decoder_threads >= 0);
+
+        close();
+
+        // The decoders share the hardware threads between them, unless told otherwise.
+        const int threads_per_decoder = decoder_threads > 0 ? decoder_threads
+            : std::max(static_cast<int>(std::thread::hardware_concurrency() / decoders), 1);
+
+        const std::vector<int> properties = {
+            cv::CAP_PROP_N_THREADS, threads_per_decoder
+        };
+
+        for(uint32_t i = 0; i < decoders; i++)
+        {
+            auto& capture = m_Captures.emplace_back(path.string(), cv::CAP_FFMPEG, properties);
+            if(!capture.isOpened())
+            {
+                close();
+                return cv::format("Failed to open the input video \'%s\'", path.string().c_str());
+            }
+        }
+
+        m_Framerate = std::max(m_Captures.front().get(cv::CAP_PROP_FPS), 1.0);
+        m_FourCC = static_cast<int>(m_Captures.front().get(cv::CAP_PROP_FOURCC));
+        m_FrameCount = static_cast<uint64_t>(std::max(m_Captures.front().get(cv::CAP_PROP_FRAME_COUNT), 0.0));
+
+        m_ChunkFrames = chunk_frames;
+        m_NextChunk = 0;
+        m_ReadChunk = 0;
+        m_FramesRead = 0;
+        m_Stopping = false;
+
+        for(auto& capture : m_Captures)
+            m_Decoders.emplace_back(&ParallelDecoder::run_decoder, this, std::ref(capture));
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ParallelDecoder::run_decoder(cv::VideoCapture& capture)
+    {
+        uint64_t position = 0;
+        lvk::Frame frame;
+
+        while(true)
+        {
+            // Claim the next chunk, staying within a chunk per decoder of the reader to bound memory.
+            uint64_t chunk_index = 0;
+            {
+                std::unique_lock lock(m_ChunkMutex);
+                m_ChunkUpdated.wait(lock, [&](){
+                    return m_Stopping || m_NextChunk < m_ReadChunk + m_Captures.size();
+                });
+
+                if(m_Stopping)
+                    return;
+
+                chunk_index = m_NextChunk++;
+                m_Chunks[chunk_index];
+            }
+
+            // The decoder seeks to the preceding keyframe and decodes up to the chunk.
+            const uint64_t chunk_start = chunk_index * m_ChunkFrames;
+            if(position != chunk_start)
+                capture.set(cv::CAP_PROP_POS_FRAMES, static_cast<double>(chunk_start));
+            position = chunk_start;
+
+            bool end_of_stream = false;
+            for(uint32_t i = 0; i < m_ChunkFrames; i++)
+            {
+                if(!capture.read(frame))
+                {
+                    end_of_stream = true;
+                    break;
+                }
+
+                // Seeking can leave the position unreliable, so timestamps come from the frame index.
+                frame.format = lvk::VideoFrame::BGR;
+                frame.timestamp = static_cast<uint64_t>(
+                    (lvk::Time::Timestep(m_Framerate) * static_cast<double>(position++)).nanoseconds()
+                );
+
+                std::scoped_lock lock(m_ChunkMutex);
+                if(m_Stopping)
+                    return;
+
+                m_Chunks[chunk_index].frames.push_back(std::move(frame));
+                m_ChunkUpdated.notify_all();
+            }
+
+            std::scoped_lock lock(m_ChunkMutex);
+            auto& chunk = m_Chunks[chunk_index];
+            chunk.finished = true;
+            chunk.end_of_stream = end_of_stream;
+            m_ChunkUpdated.notify_all();
+
+            // No chunks past the end of the stream are needed.
+            if(end_of_stream)
+                return;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool ParallelDecoder::read(lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+
+        std::unique_lock lock(m_ChunkMutex);
+        while(true)
+        {
+            m_ChunkUpdated.wait(lock, [&](){
+                const auto chunk = m_Chunks.find(m_ReadChunk);
+                return m_Stopping || (chunk != m_Chunks.end() && (!chunk->second.frames.empty() || chunk->second.finished));
+            });
+
+            if(m_Stopping)
+                return false;
+
+            auto& chunk = m_Chunks[m_ReadChunk];
+            if(!chunk.frames.empty())
+            {
+                frame = std::move(chunk.frames.front());
+                chunk.frames.pop_front();
+                m_FramesRead++;
+                return true;
+            }
+
+            // The chunk is finished, so move onto the next, letting another decoder start.
+            const bool end_of_stream = chunk.end_of_stream;
+            m_Chunks.erase(m_ReadChunk++);
+            m_ChunkUpdated.notify_all();
+
+            if(end_of_stream)
+                return false;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ParallelDecoder::close()
+    {
+        {
+            std::scoped_lock lock(m_ChunkMutex);
+            m_Stopping = true;
+            m_ChunkUpdated.notify_all();
+        }
+
+        for(auto& decoder : m_Decoders)
+            if(decoder.joinable())
+                decoder.join();
+
+        m_Decoders.clear();
+        m_Captures.clear();
+        m_Chunks.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool ParallelDecoder::is_open() const
+    {
+        return !m_Captures.empty();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double ParallelDecoder::framerate() const
+    {
+        return m_Framerate;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    int ParallelDecoder::fourcc() const
+    {
+        return m_FourCC;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t ParallelDecoder::frame_count() const
+    {
+        return m_FrameCount;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t ParallelDecoder::frames_read() const
+    {
+        return m_FramesRead;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
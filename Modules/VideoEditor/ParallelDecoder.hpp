@@ -0,0 +1,98 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <condition_variable>
+#include <filesystem>
+#include <optional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <map>
+
+namespace clt
+{
+
+    // Decodes a video file with several decoder instances at once, each decoding its own chunk
+    // of consecutive frames, while delivering the frames in order. Each chunk starts with a seek,
+    // so this suits all-intra sources, or long-GOP sources with chunks spanning several GOPs.
+    class ParallelDecoder
+    {
+    public:
+
+        ParallelDecoder() = default;
+
+        ~ParallelDecoder();
+
+        ParallelDecoder(const ParallelDecoder&) = delete;
+
+        ParallelDecoder& operator=(const ParallelDecoder&) = delete;
+
+
+        std::optional<std::string> open(
+            const std::filesystem::path& path,
+            const uint32_t decoders,
+            const uint32_t chunk_frames,
+            const int decoder_threads = 0
+        );
+
+        bool read(lvk::Frame& frame);
+
+        void close();
+
+
+        bool is_open() const;
+
+        double framerate() const;
+
+        int fourcc() const;
+
+        uint64_t frame_count() const;
+
+        uint64_t frames_read() const;
+
+    private:
+
+        struct Chunk
+        {
+            std::deque<lvk::Frame> frames;
+            bool finished = false, end_of_stream = false;
+        };
+
+        void run_decoder(cv::VideoCapture& capture);
+
+    private:
+        std::vector<std::thread> m_Decoders;
+        std::vector<cv::VideoCapture> m_Captures;
+
+        std::mutex m_ChunkMutex;
+        std::condition_variable m_ChunkUpdated;
+        std::map<uint64_t, Chunk> m_Chunks;
+        uint64_t m_NextChunk = 0, m_ReadChunk = 0;
+        bool m_Stopping = false;
+
+        uint32_t m_ChunkFrames = 0;
+        double m_Framerate = 30.0;
+        int m_FourCC = 0;
+        uint64_t m_FrameCount = 0;
+        std::atomic<uint64_t> m_FramesRead = 0;
+    };
+
+}
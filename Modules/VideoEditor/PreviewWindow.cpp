@@ -0,0 +1,187 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "PreviewWindow.hpp"
+
+#include <opencv2/highgui.hpp>
+#include <algorithm>
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Initial bounds of the preview, before the window reports its own size.
+    const cv::Size DEFAULT_PREVIEW_SIZE = {1280, 720};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    PreviewWindow::~PreviewWindow()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PreviewWindow::open(const std::string& title, const lvk::Time& refresh_period)
+    {
+        LVK_ASSERT(!is_open());
+        LVK_ASSERT(!title.empty());
+
+        m_Title = title;
+        m_RefreshPeriod = refresh_period;
+        m_HasPendingFrame = false;
+        m_WindowSize = {};
+        m_Closed = false;
+        m_Running = true;
+
+        m_SubmitTimer.restart();
+        m_DisplayThread = std::thread(&PreviewWindow::run, this);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PreviewWindow::submit(const lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+
+        if(m_Closed)
+            return false;
+
+        // Frames arriving faster than the refresh rate would never be seen, so skip them early.
+        if(m_SubmitTimer.elapsed() < m_RefreshPeriod || frame.empty())
+            return true;
+        m_SubmitTimer.restart();
+
+        // Scale down on the GPU before reformatting, so the display thread only downloads a small frame.
+        const cv::Size size = preview_size(frame.size());
+        if(size != frame.size())
+        {
+            cv::resize(frame, m_ScaleBuffer, size, 0, 0, cv::INTER_AREA);
+            m_ScaleBuffer.format = frame.format;
+        }
+        else frame.copyTo(m_ScaleBuffer);
+
+        if(m_ScaleBuffer.format != lvk::VideoFrame::BGR && m_ScaleBuffer.format != lvk::VideoFrame::UNKNOWN)
+            m_ScaleBuffer.reformat(lvk::VideoFrame::BGR);
+
+        // Replace whatever the display thread has not yet shown.
+        std::scoped_lock frame_lock(m_FrameMutex);
+        std::swap(m_PendingFrame, m_ScaleBuffer);
+        m_HasPendingFrame = true;
+        m_FrameAvailable.notify_one();
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PreviewWindow::close()
+    {
+        {
+            std::scoped_lock frame_lock(m_FrameMutex);
+            m_Running = false;
+            m_FrameAvailable.notify_one();
+        }
+
+        if(m_DisplayThread.joinable())
+            m_DisplayThread.join();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PreviewWindow::run()
+    {
+        // The window is owned by this thread, as GUI backends expect all calls from one thread.
+        cv::namedWindow(m_Title, cv::WINDOW_NORMAL | cv::WINDOW_KEEPRATIO);
+
+        lvk::Frame frame;
+        while(m_Running)
+        {
+            {
+                std::unique_lock frame_lock(m_FrameMutex);
+                m_FrameAvailable.wait_for(frame_lock, std::chrono::nanoseconds(
+                    static_cast<int64_t>(m_RefreshPeriod.nanoseconds())
+                ));
+
+                if(m_HasPendingFrame)
+                {
+                    std::swap(frame, m_PendingFrame);
+                    m_HasPendingFrame = false;
+                }
+                else frame.release();
+            }
+
+            if(!frame.empty())
+                cv::imshow(m_Title, frame);
+
+            // Polling events is also what keeps the window responsive while idle.
+            if(cv::pollKey() == 27)
+            {
+                m_Closed = true;
+                break;
+            }
+
+            const cv::Rect window_region = cv::getWindowImageRect(m_Title);
+            std::scoped_lock frame_lock(m_FrameMutex);
+            m_WindowSize = window_region.size();
+        }
+
+        cv::destroyWindow(m_Title);
+        cv::pollKey();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Size PreviewWindow::preview_size(const cv::Size& frame_size)
+    {
+        cv::Size bounds = DEFAULT_PREVIEW_SIZE;
+        {
+            std::scoped_lock frame_lock(m_FrameMutex);
+            if(m_WindowSize.area() > 0)
+                bounds = m_WindowSize;
+        }
+
+        // Only ever scale down, keeping the aspect ratio of the frame.
+        const double scale = std::min({
+            1.0,
+            static_cast<double>(bounds.width) / frame_size.width,
+            static_cast<double>(bounds.height) / frame_size.height
+        });
+
+        return {
+            std::max(static_cast<int>(frame_size.width * scale), 1),
+            std::max(static_cast<int>(frame_size.height * scale), 1)
+        };
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PreviewWindow::is_open() const
+    {
+        return m_Running;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PreviewWindow::was_closed() const
+    {
+        return m_Closed;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
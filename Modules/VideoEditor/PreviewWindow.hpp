@@ -0,0 +1,73 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <mutex>
+
+namespace clt
+{
+
+    // Displays frames on a dedicated GUI thread, so that a slow window never holds back
+    // processing. Only the latest frame is kept, downscaled to the window size, and the
+    // window is refreshed at most once per refresh period. Pressing escape closes it.
+    class PreviewWindow
+    {
+    public:
+
+        PreviewWindow() = default;
+
+        ~PreviewWindow();
+
+        void open(const std::string& title, const lvk::Time& refresh_period);
+
+        bool submit(const lvk::Frame& frame);
+
+        void close();
+
+
+        bool is_open() const;
+
+        bool was_closed() const;
+
+    private:
+
+        void run();
+
+        cv::Size preview_size(const cv::Size& frame_size);
+
+    private:
+        std::string m_Title;
+        std::thread m_DisplayThread;
+        lvk::Time m_RefreshPeriod;
+        lvk::Stopwatch m_SubmitTimer;
+
+        std::mutex m_FrameMutex;
+        std::condition_variable m_FrameAvailable;
+        lvk::Frame m_PendingFrame, m_ScaleBuffer;
+        bool m_HasPendingFrame = false;
+        cv::Size m_WindowSize;
+
+        std::atomic_bool m_Running = false, m_Closed = false;
+    };
+
+}
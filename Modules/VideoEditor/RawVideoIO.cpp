@@ -0,0 +1,424 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "RawVideoIO.hpp"
+
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <cmath>
+
+#ifdef WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Large stream buffers keep pipe reads and writes to a few syscalls per frame.
+    constexpr size_t STREAM_BUFFER_SIZE = 8 * 1024 * 1024;
+    constexpr size_t MAX_Y4M_HEADER_LENGTH = 1024;
+
+    constexpr const char* Y4M_STREAM_MAGIC = "YUV4MPEG2";
+    constexpr const char* Y4M_FRAME_MAGIC = "FRAME";
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<RawVideoSource> parse_raw_video_target(const std::string& target)
+    {
+        if(target == "-" || target == "y4m:-")
+            return RawVideoSource{"-", true};
+
+        if(target == "yuv:-")
+            return RawVideoSource{"-", false};
+
+        const std::filesystem::path path = target;
+        if(path.extension() == ".y4m")
+            return RawVideoSource{path, true};
+
+        if(path.extension() == ".yuv")
+            return RawVideoSource{path, false};
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    FILE* open_stream(const std::filesystem::path& path, const bool write)
+    {
+        FILE* file = nullptr;
+        if(path == "-")
+        {
+            file = write ? stdout : stdin;
+#ifdef WIN32
+            // The standard streams default to text mode on Windows, which would mangle the frame data.
+            _setmode(_fileno(file), _O_BINARY);
+#endif
+        }
+        else file = std::fopen(path.string().c_str(), write ? "wb" : "rb");
+
+        if(file != nullptr)
+            std::setvbuf(file, nullptr, _IOFBF, STREAM_BUFFER_SIZE);
+
+        return file;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool read_line(FILE* file, std::string& line)
+    {
+        line.clear();
+        for(int c = std::fgetc(file); c != '\n'; c = std::fgetc(file))
+        {
+            if(c == EOF || line.size() >= MAX_Y4M_HEADER_LENGTH)
+                return false;
+
+            line.push_back(static_cast<char>(c));
+        }
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    RawVideoReader::~RawVideoReader()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> RawVideoReader::open(
+        const RawVideoSource& source,
+        const std::optional<RawVideoSettings>& raw_settings
+    )
+    {
+        close();
+
+        const auto stream_name = source.path == "-" ? std::string("stdin") : source.path.string();
+        if(!source.y4m && !raw_settings.has_value())
+        {
+            return cv::format(
+                "Raw video input \'%s\' has no header, its resolution and framerate must be given with --raw",
+                stream_name.c_str()
+            );
+        }
+
+        m_File = open_stream(source.path, false);
+        if(m_File == nullptr)
+            return cv::format("Failed to open raw video input \'%s\'", stream_name.c_str());
+
+        m_OwnsFile = source.path != "-";
+        m_Y4M = source.y4m;
+        m_Monochrome = false;
+        m_FramesRead = 0;
+
+        if(m_Y4M)
+        {
+            if(auto error = parse_y4m_header(); error.has_value())
+            {
+                close();
+                return cv::format("%s in \'%s\'", error->c_str(), stream_name.c_str());
+            }
+        }
+        else
+        {
+            m_Resolution = raw_settings->resolution;
+            m_Framerate = raw_settings->framerate;
+            m_ChromaSize = cv::Size((m_Resolution.width + 1) / 2, (m_Resolution.height + 1) / 2);
+        }
+
+        // The whole frame is read straight into this buffer, which the planes are then viewed from.
+        const int chroma_area = m_Monochrome ? 0 : m_ChromaSize.area();
+        m_FrameBuffer.create(1, m_Resolution.area() + 2 * chroma_area, CV_8UC1);
+
+        if(m_Monochrome)
+        {
+            m_ChannelBuffers[1].create(m_Resolution, CV_8UC1);
+            m_ChannelBuffers[1].setTo(cv::Scalar(128));
+            m_ChannelBuffers[2] = m_ChannelBuffers[1];
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> RawVideoReader::parse_y4m_header()
+    {
+        std::string header;
+        if(!read_line(m_File, header) || header.rfind(Y4M_STREAM_MAGIC, 0) != 0)
+            return "Missing Y4M stream header";
+
+        // Header is a set of space separated parameters, each prefixed by a single character tag.
+        int width = 0, height = 0, rate_num = 30, rate_den = 1;
+        std::string colourspace = "420jpeg";
+
+        std::stringstream parameters(header.substr(std::strlen(Y4M_STREAM_MAGIC)));
+        for(std::string parameter; parameters >> parameter;)
+        {
+            const auto value = parameter.substr(1);
+            switch(parameter[0])
+            {
+                case 'W': width = std::atoi(value.c_str()); break;
+                case 'H': height = std::atoi(value.c_str()); break;
+                case 'F': std::sscanf(value.c_str(), "%d:%d", &rate_num, &rate_den); break;
+                case 'C': colourspace = value; break;
+                default: break; // Interlacing, aspect ratio and extensions do not affect decoding.
+            }
+        }
+
+        if(width <= 0 || height <= 0)
+            return "Invalid Y4M resolution";
+
+        if(rate_num <= 0 || rate_den <= 0)
+            return "Invalid Y4M framerate";
+
+        m_Resolution = cv::Size(width, height);
+        m_Framerate = static_cast<double>(rate_num) / static_cast<double>(rate_den);
+
+        // Only 8-bit colourspaces are supported, all 4:2:0 chroma sitings are treated the same.
+        if(colourspace == "420" || colourspace == "420jpeg" || colourspace == "420paldv" || colourspace == "420mpeg2")
+            m_ChromaSize = cv::Size((width + 1) / 2, (height + 1) / 2);
+        else if(colourspace == "422")
+            m_ChromaSize = cv::Size((width + 1) / 2, height);
+        else if(colourspace == "444")
+            m_ChromaSize = m_Resolution;
+        else if(colourspace == "mono")
+            m_Monochrome = true;
+        else
+            return cv::format("Unsupported Y4M colourspace \'%s\'", colourspace.c_str());
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool RawVideoReader::skip_y4m_frame_header()
+    {
+        // Frame parameters are never used in practice, so the rest of the line is ignored.
+        std::string header;
+        return read_line(m_File, header) && header.rfind(Y4M_FRAME_MAGIC, 0) == 0;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool RawVideoReader::read(lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+
+        if(m_Y4M && !skip_y4m_frame_header())
+            return false;
+
+        const auto frame_bytes = m_FrameBuffer.total();
+        if(std::fread(m_FrameBuffer.data, 1, frame_bytes, m_File) != frame_bytes)
+            return false;
+
+        // View each plane in place, only the chroma planes need resampling to the packed YUV format.
+        uint8_t* plane_data = m_FrameBuffer.data;
+        m_ChannelBuffers[0] = cv::Mat(m_Resolution, CV_8UC1, plane_data);
+
+        if(!m_Monochrome)
+        {
+            plane_data += m_Resolution.area();
+            const cv::Mat u_plane(m_ChromaSize, CV_8UC1, plane_data);
+            const cv::Mat v_plane(m_ChromaSize, CV_8UC1, plane_data + m_ChromaSize.area());
+
+            if(m_ChromaSize != m_Resolution)
+            {
+                cv::resize(u_plane, m_ChannelBuffers[1], m_Resolution, 0, 0, cv::INTER_LINEAR);
+                cv::resize(v_plane, m_ChannelBuffers[2], m_Resolution, 0, 0, cv::INTER_LINEAR);
+            }
+            else
+            {
+                m_ChannelBuffers[1] = u_plane;
+                m_ChannelBuffers[2] = v_plane;
+            }
+        }
+
+        cv::merge(m_ChannelBuffers, 3, frame);
+        frame.format = lvk::VideoFrame::YUV;
+        frame.timestamp = static_cast<uint64_t>(
+            (lvk::Time::Timestep(m_Framerate) * static_cast<double>(m_FramesRead)).nanoseconds()
+        );
+
+        m_FramesRead++;
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void RawVideoReader::close()
+    {
+        if(m_File != nullptr && m_OwnsFile)
+            std::fclose(m_File);
+
+        m_File = nullptr;
+        m_OwnsFile = false;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool RawVideoReader::is_open() const
+    {
+        return m_File != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const cv::Size& RawVideoReader::resolution() const
+    {
+        return m_Resolution;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double RawVideoReader::framerate() const
+    {
+        return m_Framerate;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t RawVideoReader::frames_read() const
+    {
+        return m_FramesRead;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    RawVideoWriter::~RawVideoWriter()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> RawVideoWriter::open(
+        const RawVideoSource& target,
+        const cv::Size& resolution,
+        const double framerate
+    )
+    {
+        LVK_ASSERT(resolution.width > 0 && resolution.height > 0);
+        LVK_ASSERT(framerate > 0);
+
+        close();
+
+        const auto stream_name = target.path == "-" ? std::string("stdout") : target.path.string();
+        m_File = open_stream(target.path, true);
+        if(m_File == nullptr)
+            return cv::format("Failed to open raw video output \'%s\'", stream_name.c_str());
+
+        m_OwnsFile = target.path != "-";
+        m_Y4M = target.y4m;
+        m_Resolution = resolution;
+        m_ChromaSize = cv::Size((resolution.width + 1) / 2, (resolution.height + 1) / 2);
+        m_FrameBuffer.create(1, m_Resolution.area() + 2 * m_ChromaSize.area(), CV_8UC1);
+
+        if(m_Y4M)
+        {
+            // Express the framerate as a ratio, keeping NTSC rates such as 29.97 exact.
+            int rate_num = static_cast<int>(std::round(framerate * 1000.0)), rate_den = 1000;
+            if(const double ntsc_rate = framerate * 1.001; std::abs(ntsc_rate - std::round(ntsc_rate)) < 1e-3)
+            {
+                rate_num = static_cast<int>(std::round(ntsc_rate)) * 1000;
+                rate_den = 1001;
+            }
+            if(std::abs(framerate - std::round(framerate)) < 1e-6)
+            {
+                rate_num = static_cast<int>(std::round(framerate));
+                rate_den = 1;
+            }
+
+            const int written = std::fprintf(
+                m_File, "%s W%d H%d F%d:%d Ip A1:1 C420jpeg\n",
+                Y4M_STREAM_MAGIC, resolution.width, resolution.height, rate_num, rate_den
+            );
+
+            if(written < 0)
+            {
+                close();
+                return cv::format("Failed to write Y4M header to \'%s\'", stream_name.c_str());
+            }
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void RawVideoWriter::write(const lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+        LVK_ASSERT(frame.size() == m_Resolution);
+
+        if(frame.format != lvk::VideoFrame::YUV)
+        {
+            frame.reformatTo(m_YUVFrame, lvk::VideoFrame::YUV);
+            m_YUVFrame.copyTo(m_HostFrame);
+        }
+        else frame.copyTo(m_HostFrame);
+
+        cv::split(m_HostFrame, m_Channels);
+
+        // Planes are written straight into the frame buffer, so the whole frame goes out in one write.
+        uint8_t* plane_data = m_FrameBuffer.data;
+        cv::Mat y_plane(m_Resolution, CV_8UC1, plane_data);
+        cv::Mat u_plane(m_ChromaSize, CV_8UC1, plane_data + m_Resolution.area());
+        cv::Mat v_plane(m_ChromaSize, CV_8UC1, plane_data + m_Resolution.area() + m_ChromaSize.area());
+
+        m_Channels[0].copyTo(y_plane);
+        cv::resize(m_Channels[1], u_plane, m_ChromaSize, 0, 0, cv::INTER_AREA);
+        cv::resize(m_Channels[2], v_plane, m_ChromaSize, 0, 0, cv::INTER_AREA);
+
+        if(m_Y4M && std::fprintf(m_File, "%s\n", Y4M_FRAME_MAGIC) < 0)
+            throw std::runtime_error("failed to write Y4M frame header");
+
+        const auto frame_bytes = m_FrameBuffer.total();
+        if(std::fwrite(m_FrameBuffer.data, 1, frame_bytes, m_File) != frame_bytes)
+            throw std::runtime_error(cv::format("raw video stream closed (%s)", std::strerror(errno)));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void RawVideoWriter::close()
+    {
+        if(m_File != nullptr)
+        {
+            if(m_OwnsFile)
+                std::fclose(m_File);
+            else
+                std::fflush(m_File);
+        }
+
+        m_File = nullptr;
+        m_OwnsFile = false;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool RawVideoWriter::is_open() const
+    {
+        return m_File != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,136 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <filesystem>
+#include <optional>
+#include <atomic>
+#include <cstdio>
+
+namespace clt
+{
+
+    // Header-less raw video is assumed to be 8-bit planar I420.
+    struct RawVideoSettings
+    {
+        cv::Size resolution;
+        double framerate = 30.0;
+    };
+
+    struct RawVideoSource
+    {
+        std::filesystem::path path; // "-" for the standard streams
+        bool y4m = true;
+    };
+
+    // Returns the raw video stream described by the given target, if it is one. Raw streams
+    // are either '-' or 'y4m:-' for Y4M and 'yuv:-' for raw I420 over the standard streams,
+    // or a file or named pipe ending in '.y4m' or '.yuv'.
+    std::optional<RawVideoSource> parse_raw_video_target(const std::string& target);
+
+
+    // Reads Y4M or raw planar YUV from a file, pipe or stdin into packed YUV VideoFrames.
+    class RawVideoReader
+    {
+    public:
+
+        RawVideoReader() = default;
+
+        ~RawVideoReader();
+
+        RawVideoReader(const RawVideoReader&) = delete;
+
+        RawVideoReader& operator=(const RawVideoReader&) = delete;
+
+
+        std::optional<std::string> open(
+            const RawVideoSource& source,
+            const std::optional<RawVideoSettings>& raw_settings = std::nullopt
+        );
+
+        bool read(lvk::Frame& frame);
+
+        void close();
+
+
+        bool is_open() const;
+
+        const cv::Size& resolution() const;
+
+        double framerate() const;
+
+        uint64_t frames_read() const;
+
+    private:
+
+        std::optional<std::string> parse_y4m_header();
+
+        bool skip_y4m_frame_header();
+
+    private:
+        FILE* m_File = nullptr;
+        bool m_OwnsFile = false, m_Y4M = false;
+
+        cv::Size m_Resolution, m_ChromaSize;
+        bool m_Monochrome = false;
+        double m_Framerate = 30.0;
+
+        cv::Mat m_FrameBuffer;
+        cv::Mat m_ChannelBuffers[3];
+        std::atomic<uint64_t> m_FramesRead = 0;
+    };
+
+
+    // Writes packed YUV VideoFrames as Y4M (C420jpeg) or raw I420 to a file, pipe or stdout.
+    class RawVideoWriter
+    {
+    public:
+
+        RawVideoWriter() = default;
+
+        ~RawVideoWriter();
+
+        RawVideoWriter(const RawVideoWriter&) = delete;
+
+        RawVideoWriter& operator=(const RawVideoWriter&) = delete;
+
+
+        std::optional<std::string> open(
+            const RawVideoSource& target,
+            const cv::Size& resolution,
+            const double framerate
+        );
+
+        void write(const lvk::Frame& frame);
+
+        void close();
+
+        bool is_open() const;
+
+    private:
+        FILE* m_File = nullptr;
+        bool m_OwnsFile = false, m_Y4M = false;
+
+        cv::Size m_Resolution, m_ChromaSize;
+        lvk::VideoFrame m_YUVFrame;
+        cv::Mat m_HostFrame, m_FrameBuffer;
+        cv::Mat m_Channels[3];
+    };
+
+}
@@ -0,0 +1,108 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "ResourceUsage.hpp"
+
+#ifdef WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#ifdef __linux__
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    ResourceUsage ResourceUsage::Query()
+    {
+        ResourceUsage usage;
+
+#ifdef WIN32
+        // Process times are given in 100ns intervals.
+        FILETIME creation_time, exit_time, kernel_time, user_time;
+        if(GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time))
+        {
+            const auto to_nanoseconds = [](const FILETIME& time){
+                return 100 * ((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime);
+            };
+            usage.cpu_time = lvk::Time(to_nanoseconds(kernel_time) + to_nanoseconds(user_time));
+
+            FILETIME current_time;
+            GetSystemTimeAsFileTime(&current_time);
+            usage.uptime = lvk::Time(to_nanoseconds(current_time) - to_nanoseconds(creation_time));
+        }
+
+        PROCESS_MEMORY_COUNTERS memory_counters;
+        if(GetProcessMemoryInfo(GetCurrentProcess(), &memory_counters, sizeof(memory_counters)))
+            usage.peak_memory = memory_counters.PeakWorkingSetSize;
+#else
+        rusage resources{};
+        if(getrusage(RUSAGE_SELF, &resources) == 0)
+        {
+            const auto to_seconds = [](const timeval& time){
+                return static_cast<double>(time.tv_sec) + 1e-6 * static_cast<double>(time.tv_usec);
+            };
+            usage.cpu_time = lvk::Time::Seconds(to_seconds(resources.ru_utime) + to_seconds(resources.ru_stime));
+
+        #ifdef __APPLE__
+            usage.peak_memory = static_cast<size_t>(resources.ru_maxrss);
+        #else
+            // Linux reports the maximum resident set size in kilobytes.
+            usage.peak_memory = static_cast<size_t>(resources.ru_maxrss) * 1024;
+        #endif
+        }
+
+    #ifdef __linux__
+        // The process start time is the 22nd field of its stat file, in clock ticks since boot.
+        // Fields are counted from after the executable name, as the name may contain spaces.
+        std::ifstream stat_file("/proc/self/stat");
+        std::string stat_line;
+        timespec boot_time{};
+        if(std::getline(stat_file, stat_line) && clock_gettime(CLOCK_BOOTTIME, &boot_time) == 0)
+        {
+            std::istringstream fields(stat_line.substr(stat_line.rfind(')') + 1));
+            double start_ticks = 0.0;
+            std::string field;
+            for(int i = 3; i < 22; i++)
+                fields >> field;
+
+            if(fields >> start_ticks)
+            {
+                const double start_time = start_ticks / static_cast<double>(sysconf(_SC_CLK_TCK));
+                const double current_time = static_cast<double>(boot_time.tv_sec) + 1e-9 * static_cast<double>(boot_time.tv_nsec);
+                usage.uptime = lvk::Time::Seconds(std::max(current_time - start_time, 0.0));
+            }
+        }
+    #endif
+#endif
+
+        return usage;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,483 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "SharedFrameIO.hpp"
+
+#include <climits>
+#include <cstring>
+#include <cerrno>
+#include <thread>
+#include <new>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr uint32_t SHARED_FRAME_MAGIC = 0x4C564B46; // 'LVKF'
+    constexpr uint32_t SHARED_FRAME_VERSION = 2;
+    constexpr uint32_t MAX_FRAME_SLOTS = 16;
+    constexpr size_t SLOT_ALIGNMENT = 4096;
+
+    // Slots are sized for the largest 8-bit frame format, so any format can be passed through.
+    constexpr size_t MAX_SLOT_CHANNELS = 4;
+
+    // Waits are bounded so that a peer which exits without closing the stream is noticed,
+    // by checking whether its process still exists each time a wait times out.
+    const lvk::Time WAIT_INTERVAL = lvk::Time::Milliseconds(100);
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free && sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+    static_assert(std::atomic<int32_t>::is_always_lock_free && sizeof(std::atomic<int32_t>) == sizeof(int32_t));
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    struct SharedFrameSlot
+    {
+        uint64_t timestamp;
+        int32_t format, type;
+        uint64_t step;
+    };
+
+    // Everything but the sequences, closed flags and consumer pid is written once, before the magic is published.
+    struct SharedFrameHeader
+    {
+        std::atomic<uint32_t> magic;
+        uint32_t version;
+
+        int32_t producer_pid;
+        std::atomic<int32_t> consumer_pid;
+
+        int32_t width, height;
+        double framerate;
+
+        uint32_t slot_count;
+        uint64_t slot_size, data_offset;
+
+        // Futex words counting the frames written and read. Slots are indexed by sequence
+        // modulo the slot count, so the ring is full when the sequences differ by slot_count.
+        std::atomic<uint32_t> write_sequence, read_sequence;
+        std::atomic<uint32_t> producer_closed, consumer_closed;
+
+        SharedFrameSlot slots[MAX_FRAME_SLOTS];
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<SharedFrameSource> parse_shared_frame_target(const std::string& target)
+    {
+        constexpr const char* prefix = "shm:";
+        if(target.rfind(prefix, 0) != 0)
+            return std::nullopt;
+
+        // POSIX shared memory names are a leading slash followed by no others.
+        auto name = target.substr(std::strlen(prefix));
+        if(!name.empty() && name.front() == '/')
+            name.erase(0, 1);
+
+        if(name.empty() || name.find('/') != std::string::npos)
+            return std::nullopt;
+
+        return SharedFrameSource{name};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t align_to(const size_t size, const size_t alignment)
+    {
+        return ((size + alignment - 1) / alignment) * alignment;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint8_t* slot_data(SharedFrameHeader* header, const uint32_t index)
+    {
+        return reinterpret_cast<uint8_t*>(header) + header->data_offset + index * header->slot_size;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifdef __linux__
+
+    bool process_exited(const int32_t pid)
+    {
+        // A failed permission check still means the process exists.
+        return pid > 0 && ::kill(static_cast<pid_t>(pid), 0) == -1 && errno == ESRCH;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // The futexes are not private, as the waiting and waking processes have separate mappings.
+    void futex_wait(std::atomic<uint32_t>& word, const uint32_t expected, const lvk::Time& timeout)
+    {
+        const auto nanoseconds = static_cast<long>(timeout.nanoseconds());
+        const timespec duration = {nanoseconds / 1000000000L, nanoseconds % 1000000000L};
+
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &duration, nullptr, 0);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void futex_wake(std::atomic<uint32_t>& word)
+    {
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+#endif
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    SharedFrameReader::~SharedFrameReader()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> SharedFrameReader::open(const SharedFrameSource& source, const lvk::Time& timeout)
+    {
+        close();
+
+#ifdef __linux__
+        const auto shm_name = "/" + source.name;
+
+        // The producer may be starting alongside us, so wait for it to publish the stream.
+        lvk::Stopwatch timer;
+        timer.start();
+        while(m_Header == nullptr)
+        {
+            const int file = ::shm_open(shm_name.c_str(), O_RDWR, 0);
+            if(file >= 0)
+            {
+                struct stat file_info = {};
+                if(::fstat(file, &file_info) == 0 && static_cast<size_t>(file_info.st_size) >= sizeof(SharedFrameHeader))
+                {
+                    const auto mapping_size = static_cast<size_t>(file_info.st_size);
+                    void* mapping = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+                    if(mapping != MAP_FAILED)
+                    {
+                        auto* header = static_cast<SharedFrameHeader*>(mapping);
+                        if(header->magic.load(std::memory_order_acquire) == SHARED_FRAME_MAGIC)
+                        {
+                            m_Header = header;
+                            m_MappingSize = mapping_size;
+                        }
+                        else ::munmap(mapping, mapping_size);
+                    }
+                }
+                ::close(file);
+            }
+
+            if(m_Header == nullptr)
+            {
+                if(timer.elapsed() >= timeout)
+                    return cv::format("Timed out waiting for the shared memory stream \'shm:%s\'", source.name.c_str());
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+
+        if(m_Header->version != SHARED_FRAME_VERSION)
+        {
+            close();
+            return cv::format("Shared memory stream \'shm:%s\' has an unsupported version", source.name.c_str());
+        }
+
+        // The header comes from another process, so check it describes slots within our mapping.
+        const auto slot_count = static_cast<size_t>(m_Header->slot_count);
+        const auto slot_size = static_cast<size_t>(m_Header->slot_size);
+        const auto data_offset = static_cast<size_t>(m_Header->data_offset);
+        if(m_Header->width <= 0 || m_Header->height <= 0
+            || slot_count < 2 || slot_count > MAX_FRAME_SLOTS
+            || data_offset < sizeof(SharedFrameHeader) || data_offset > m_MappingSize
+            || slot_size < static_cast<size_t>(m_Header->width) * static_cast<size_t>(m_Header->height) * MAX_SLOT_CHANNELS
+            || slot_size > (m_MappingSize - data_offset) / slot_count)
+        {
+            close();
+            return cv::format("Shared memory stream \'shm:%s\' has an invalid header", source.name.c_str());
+        }
+
+        m_Header->consumer_pid.store(static_cast<int32_t>(::getpid()), std::memory_order_release);
+
+        m_FramesRead = 0;
+        m_Error.reset();
+        return std::nullopt;
+#else
+        return "Shared memory streams are only supported on Linux";
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool SharedFrameReader::read(lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+
+#ifdef __linux__
+        // Only stop once the ring is empty, so that every frame written is consumed.
+        const uint32_t sequence = m_Header->read_sequence.load(std::memory_order_relaxed);
+        while(m_Header->write_sequence.load(std::memory_order_acquire) == sequence)
+        {
+            if(m_Header->producer_closed.load(std::memory_order_acquire)
+                && m_Header->write_sequence.load(std::memory_order_acquire) == sequence)
+                return false;
+
+            if(process_exited(m_Header->producer_pid))
+            {
+                m_Error = "Shared memory stream producer exited without closing the stream";
+                return false;
+            }
+
+            futex_wait(m_Header->write_sequence, sequence, WAIT_INTERVAL);
+        }
+
+        const uint32_t index = sequence % m_Header->slot_count;
+        const auto& slot = m_Header->slots[index];
+
+        const auto row_size = static_cast<uint64_t>(m_Header->width) * CV_ELEM_SIZE(slot.type);
+        if(CV_MAT_DEPTH(slot.type) != CV_8U || static_cast<size_t>(CV_MAT_CN(slot.type)) > MAX_SLOT_CHANNELS
+            || slot.step < row_size || slot.step * static_cast<uint64_t>(m_Header->height) > m_Header->slot_size)
+        {
+            m_Error = "Shared memory stream produced a frame which does not fit its slot";
+            return false;
+        }
+
+        // Upload straight from the mapped slot.
+        const cv::Mat slot_view(m_Header->height, m_Header->width, slot.type, slot_data(m_Header, index), slot.step);
+        slot_view.copyTo(frame);
+        frame.format = static_cast<lvk::VideoFrame::Format>(slot.format);
+        frame.timestamp = slot.timestamp;
+
+        // Hand the slot back to the producer.
+        m_Header->read_sequence.store(sequence + 1, std::memory_order_release);
+        futex_wake(m_Header->read_sequence);
+
+        m_FramesRead++;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void SharedFrameReader::close()
+    {
+#ifdef __linux__
+        if(m_Header != nullptr)
+        {
+            // Unblock the producer if it is waiting on a slot.
+            m_Header->consumer_closed.store(1, std::memory_order_release);
+            futex_wake(m_Header->read_sequence);
+
+            ::munmap(m_Header, m_MappingSize);
+            m_Header = nullptr;
+        }
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool SharedFrameReader::is_open() const
+    {
+        return m_Header != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Size SharedFrameReader::resolution() const
+    {
+        LVK_ASSERT(is_open());
+        return {m_Header->width, m_Header->height};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double SharedFrameReader::framerate() const
+    {
+        LVK_ASSERT(is_open());
+        return m_Header->framerate;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t SharedFrameReader::frames_read() const
+    {
+        return m_FramesRead;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::optional<std::string>& SharedFrameReader::error() const
+    {
+        return m_Error;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    SharedFrameWriter::~SharedFrameWriter()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> SharedFrameWriter::open(
+        const SharedFrameSource& target,
+        const cv::Size& resolution,
+        const double framerate,
+        const uint32_t slots
+    )
+    {
+        LVK_ASSERT(slots >= 2 && slots <= MAX_FRAME_SLOTS);
+        LVK_ASSERT(resolution.width > 0 && resolution.height > 0);
+
+        close();
+
+#ifdef __linux__
+        const auto shm_name = "/" + target.name;
+
+        const size_t data_offset = align_to(sizeof(SharedFrameHeader), SLOT_ALIGNMENT);
+        const size_t slot_size = align_to(static_cast<size_t>(resolution.area()) * MAX_SLOT_CHANNELS, SLOT_ALIGNMENT);
+        const size_t mapping_size = data_offset + slots * slot_size;
+
+        // Replace any stream left behind by a producer which did not exit cleanly.
+        ::shm_unlink(shm_name.c_str());
+
+        const int file = ::shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if(file < 0)
+        {
+            return cv::format(
+                "Failed to create the shared memory stream \'shm:%s\' (%s)",
+                target.name.c_str(),
+                std::strerror(errno)
+            );
+        }
+
+        void* mapping = MAP_FAILED;
+        if(::ftruncate(file, static_cast<off_t>(mapping_size)) == 0)
+            mapping = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        ::close(file);
+
+        if(mapping == MAP_FAILED)
+        {
+            ::shm_unlink(shm_name.c_str());
+            return cv::format(
+                "Failed to map the shared memory stream \'shm:%s\' (%s)",
+                target.name.c_str(),
+                std::strerror(errno)
+            );
+        }
+
+        m_Header = new(mapping) SharedFrameHeader{};
+        m_Header->version = SHARED_FRAME_VERSION;
+        m_Header->producer_pid = static_cast<int32_t>(::getpid());
+        m_Header->width = resolution.width;
+        m_Header->height = resolution.height;
+        m_Header->framerate = framerate;
+        m_Header->slot_count = slots;
+        m_Header->slot_size = slot_size;
+        m_Header->data_offset = data_offset;
+
+        // Consumers only attach once the magic is visible, after the rest of the header.
+        m_Header->magic.store(SHARED_FRAME_MAGIC, std::memory_order_release);
+
+        m_Name = shm_name;
+        m_MappingSize = mapping_size;
+        return std::nullopt;
+#else
+        return "Shared memory streams are only supported on Linux";
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void SharedFrameWriter::write(const lvk::Frame& frame)
+    {
+        LVK_ASSERT(is_open());
+        LVK_ASSERT(frame.cols == m_Header->width && frame.rows == m_Header->height);
+        LVK_ASSERT(frame.depth() == CV_8U && static_cast<size_t>(frame.channels()) <= MAX_SLOT_CHANNELS);
+
+#ifdef __linux__
+        // Wait for the consumer to free up a slot.
+        const uint32_t sequence = m_Header->write_sequence.load(std::memory_order_relaxed);
+        for(uint32_t read = m_Header->read_sequence.load(std::memory_order_acquire);
+            sequence - read >= m_Header->slot_count;
+            read = m_Header->read_sequence.load(std::memory_order_acquire))
+        {
+            if(m_Header->consumer_closed.load(std::memory_order_acquire))
+                throw std::runtime_error("shared memory stream was closed by its consumer");
+
+            if(process_exited(m_Header->consumer_pid.load(std::memory_order_acquire)))
+                throw std::runtime_error("shared memory stream consumer exited without closing the stream");
+
+            futex_wait(m_Header->read_sequence, read, WAIT_INTERVAL);
+        }
+
+        const uint32_t index = sequence % m_Header->slot_count;
+        auto& slot = m_Header->slots[index];
+
+        // The view matches the frame, so the download lands straight in the mapped slot.
+        cv::Mat slot_view(frame.rows, frame.cols, frame.type(), slot_data(m_Header, index));
+        frame.copyTo(slot_view);
+
+        slot.timestamp = frame.timestamp;
+        slot.format = static_cast<int32_t>(frame.format);
+        slot.type = frame.type();
+        slot.step = slot_view.step;
+
+        m_Header->write_sequence.store(sequence + 1, std::memory_order_release);
+        futex_wake(m_Header->write_sequence);
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void SharedFrameWriter::close()
+    {
+#ifdef __linux__
+        if(m_Header != nullptr)
+        {
+            m_Header->producer_closed.store(1, std::memory_order_release);
+            futex_wake(m_Header->write_sequence);
+
+            // Attached consumers keep their mapping, so the name can be removed straight away.
+            ::munmap(m_Header, m_MappingSize);
+            ::shm_unlink(m_Name.c_str());
+            m_Header = nullptr;
+        }
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool SharedFrameWriter::is_open() const
+    {
+        return m_Header != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
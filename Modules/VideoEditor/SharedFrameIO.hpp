@@ -0,0 +1,120 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <optional>
+#include <atomic>
+#include <string>
+
+namespace clt
+{
+
+    // Shared memory streams are named 'shm:NAME', such as 'shm:lvk-capture'. The producer
+    // creates the stream, which a consumer in another process then attaches to by name.
+    struct SharedFrameSource
+    {
+        std::string name;
+    };
+
+    // Returns the shared memory stream described by the given target, if it is one.
+    std::optional<SharedFrameSource> parse_shared_frame_target(const std::string& target);
+
+    struct SharedFrameHeader;
+
+
+    // Consumes frames from a shared memory ring of frame slots, produced by another process.
+    // Frames are uploaded straight from the mapped slot, with no intermediate copies.
+    class SharedFrameReader
+    {
+    public:
+
+        SharedFrameReader() = default;
+
+        ~SharedFrameReader();
+
+        SharedFrameReader(const SharedFrameReader&) = delete;
+
+        SharedFrameReader& operator=(const SharedFrameReader&) = delete;
+
+
+        // Waits up to the timeout for the producer to create the stream.
+        std::optional<std::string> open(
+            const SharedFrameSource& source,
+            const lvk::Time& timeout = lvk::Time::Seconds(10)
+        );
+
+        bool read(lvk::Frame& frame);
+
+        void close();
+
+
+        bool is_open() const;
+
+        cv::Size resolution() const;
+
+        double framerate() const;
+
+        uint64_t frames_read() const;
+
+        // Set if the stream ended early, as the producer exited or wrote an invalid frame.
+        const std::optional<std::string>& error() const;
+
+    private:
+        SharedFrameHeader* m_Header = nullptr;
+        size_t m_MappingSize = 0;
+        std::atomic<uint64_t> m_FramesRead = 0;
+        std::optional<std::string> m_Error;
+    };
+
+
+    // Produces frames into a shared memory ring of frame slots, blocking while all slots are
+    // waiting to be consumed. Frames are downloaded straight into the mapped slot.
+    class SharedFrameWriter
+    {
+    public:
+
+        SharedFrameWriter() = default;
+
+        ~SharedFrameWriter();
+
+        SharedFrameWriter(const SharedFrameWriter&) = delete;
+
+        SharedFrameWriter& operator=(const SharedFrameWriter&) = delete;
+
+
+        std::optional<std::string> open(
+            const SharedFrameSource& target,
+            const cv::Size& resolution,
+            const double framerate,
+            const uint32_t slots = 4
+        );
+
+        void write(const lvk::Frame& frame);
+
+        void close();
+
+        bool is_open() const;
+
+    private:
+        std::string m_Name;
+        SharedFrameHeader* m_Header = nullptr;
+        size_t m_MappingSize = 0;
+    };
+
+}
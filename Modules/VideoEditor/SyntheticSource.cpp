@@ -0,0 +1,109 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "SyntheticSource.hpp"
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr int TEXTURE_BLOCK_SIZE = 16;
+    constexpr float CAMERA_MARGIN = 0.05f;
+
+    // Periods of the camera's horizontal and vertical sway, in frames.
+    constexpr double CAMERA_PERIOD_X = 90.0, CAMERA_PERIOD_Y = 47.0;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    SyntheticSource::SyntheticSource(const SyntheticSourceSettings& settings)
+        : m_Settings(settings)
+    {
+        LVK_ASSERT(settings.framerate > 0);
+        LVK_ASSERT(settings.frame_count > 0);
+        LVK_ASSERT(settings.resolution.width >= TEXTURE_BLOCK_SIZE);
+        LVK_ASSERT(settings.resolution.height >= TEXTURE_BLOCK_SIZE);
+
+        m_Margins = cv::Size(
+            static_cast<int>(CAMERA_MARGIN * static_cast<float>(settings.resolution.width)),
+            static_cast<int>(CAMERA_MARGIN * static_cast<float>(settings.resolution.height))
+        );
+
+        const cv::Size texture_size = settings.resolution + m_Margins * 2;
+        const cv::Size block_extent(
+            (texture_size.width + TEXTURE_BLOCK_SIZE - 1) / TEXTURE_BLOCK_SIZE,
+            (texture_size.height + TEXTURE_BLOCK_SIZE - 1) / TEXTURE_BLOCK_SIZE
+        );
+
+        // The scene is made of random coloured blocks with some blur, giving plenty of
+        // corners for tracking without being as unnaturally sharp as the raw blocks.
+        cv::RNG rng(settings.seed);
+        cv::Mat blocks(block_extent, CV_8UC3), texture;
+        rng.fill(blocks, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(256));
+
+        cv::resize(blocks, texture, block_extent * TEXTURE_BLOCK_SIZE, 0, 0, cv::INTER_NEAREST);
+        cv::GaussianBlur(texture, texture, cv::Size(5, 5), 0);
+
+        texture(cv::Rect({0,0}, texture_size)).copyTo(m_Texture);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool SyntheticSource::read(lvk::Frame& frame)
+    {
+        const uint32_t frame_index = m_FrameIndex;
+        if(frame_index >= m_Settings.frame_count)
+            return false;
+
+        m_Texture(cv::Rect(camera_position(frame_index), m_Settings.resolution)).copyTo(frame);
+        frame.format = lvk::VideoFrame::BGR;
+        frame.timestamp = static_cast<uint64_t>(
+            (lvk::Time::Timestep(m_Settings.framerate) * static_cast<double>(frame_index)).nanoseconds()
+        );
+
+        m_FrameIndex++;
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Point SyntheticSource::camera_position(const uint32_t frame_index) const
+    {
+        // The camera sways around the centre of the texture, staying within the margins.
+        const double t = 2.0 * CV_PI * static_cast<double>(frame_index);
+        return {
+            m_Margins.width + static_cast<int>(std::round(m_Margins.width * std::sin(t / CAMERA_PERIOD_X))),
+            m_Margins.height + static_cast<int>(std::round(m_Margins.height * std::sin(t / CAMERA_PERIOD_Y)))
+        };
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint32_t SyntheticSource::frames_read() const
+    {
+        return m_FrameIndex;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const SyntheticSourceSettings& SyntheticSource::settings() const
+    {
+        return m_Settings;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,58 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <atomic>
+
+namespace clt
+{
+
+    struct SyntheticSourceSettings
+    {
+        cv::Size resolution = {1920, 1080};
+        double framerate = 30.0;
+        uint32_t frame_count = 600;
+        uint64_t seed = 0x4C564B;
+    };
+
+    // Generates a deterministic video of a textured scene, viewed by a camera which follows a
+    // known path. This allows for the processing pipeline to be benchmarked without needing an
+    // input file, and without the variable cost of decoding that file.
+    class SyntheticSource
+    {
+    public:
+
+        explicit SyntheticSource(const SyntheticSourceSettings& settings);
+
+        bool read(lvk::Frame& frame);
+
+        cv::Point camera_position(const uint32_t frame_index) const;
+
+        uint32_t frames_read() const;
+
+        const SyntheticSourceSettings& settings() const;
+
+    private:
+        SyntheticSourceSettings m_Settings;
+        std::atomic<uint32_t> m_FrameIndex = 0;
+        cv::UMat m_Texture;
+        cv::Size m_Margins;
+    };
+
+}
@@ -18,11 +18,65 @@
 #include "VideoIOConfiguration.hpp"
 
 #include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
 #include <opencv2/opencv.hpp>
 
 namespace clt
 {
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool parse_video_specifier(const std::string& specifier, cv::Size& resolution, double& framerate)
+    {
+        // Specifier format is WxH or WxH@FPS
+        int width = 0, height = 0;
+
+        char trailing = '\0';
+        const int fields = std::sscanf(specifier.c_str(), "%dx%d@%lf%c", &width, &height, &framerate, &trailing);
+        if(fields < 2 || fields > 3 || width <= 0 || height <= 0 || framerate <= 0)
+            return false;
+
+        resolution = cv::Size(width, height);
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<StreamPosition> parse_stream_position(const std::string& specifier)
+    {
+        // Positions are either frame indices (f1200), seconds (90.5) or [hh:]mm:ss[.ms] timecodes.
+        StreamPosition position;
+        position.is_frame = !specifier.empty() && specifier.front() == 'f';
+
+        std::stringstream fields(position.is_frame ? specifier.substr(1) : specifier);
+        size_t field_count = 0;
+        for(std::string field; std::getline(fields, field, ':'); field_count++)
+        {
+            char* field_end = nullptr;
+            const double value = std::strtod(field.c_str(), &field_end);
+            if(field.empty() || *field_end != '\0' || value < 0.0 || !std::isfinite(value))
+                return std::nullopt;
+
+            position.value = position.value * 60.0 + value;
+        }
+
+        if(field_count == 0 || field_count > (position.is_frame ? 1 : 3))
+            return std::nullopt;
+
+        return position;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    lvk::Time StreamPosition::to_time(const double framerate) const
+    {
+        LVK_ASSERT(framerate > 0);
+        return is_frame ? lvk::Time::Timestep(framerate) * value : lvk::Time::Seconds(value);
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     VideoIOConfiguration::VideoIOConfiguration()
@@ -65,13 +119,105 @@ namespace clt
         if(m_ParserError.has_value())
             return m_ParserError;
 
-        if(auto error = parse_io_targets(arguments); error.has_value())
-            return error;
+        if(batch_output.has_value())
+        {
+            // In batch mode, every positional argument is an input.
+            while(!arguments.empty())
+            {
+                batch_inputs.push_back(arguments.front());
+                arguments.pop_front();
+
+                while(m_OptionParser.try_parse(arguments));
+                if(m_ParserError.has_value())
+                    return m_ParserError;
+            }
+
+            if(batch_inputs.empty())
+                return "No batch inputs were specified";
+
+            // Jobs run concurrently, so anything interactive or with a single shared target is unsupported.
+            if(render_output || log_target.has_value() || metrics_port.has_value() || metrics_socket.has_value())
+                return "Display, data logging and metrics options cannot be used in batch mode";
+
+            if(std::holds_alternative<SyntheticSourceSettings>(input_source))
+                return "Benchmarks cannot be run in batch mode";
+
+            if(batch_watch)
+            {
+                for(const auto& input : batch_inputs)
+                    if(!std::filesystem::is_directory(input))
+                        return cv::format("Watched input \'%s\' is not a directory", input.c_str());
+            }
+        }
+        else if(batch_watch)
+        {
+            return "Watching requires a batch output pattern, given with --batch";
+        }
+        else if(worker_manifest.has_value() || merge_manifest.has_value())
+        {
+            // Workers and merges take their targets from the manifest.
+            if(worker_manifest.has_value() && merge_manifest.has_value())
+                return "A manifest can be either worked on, or merged, but not both at once";
+        }
+        else if(!std::holds_alternative<SyntheticSourceSettings>(input_source))
+        {
+            // Benchmarks generate their own input and have no output.
+            if(auto error = parse_io_targets(arguments); error.has_value())
+                return error;
+        }
 
         while(m_OptionParser.try_parse(arguments));
         if(m_ParserError.has_value())
             return m_ParserError;
 
+        // A --start and/or --end is shorthand for a single range.
+        if(m_RangeStart.has_value() || m_RangeEnd.has_value())
+        {
+            if(!process_ranges.empty())
+                return "Ranges can be specified using either --start/--end or --range, but not both";
+
+            process_ranges.push_back({m_RangeStart.value_or(StreamPosition{}), m_RangeEnd});
+        }
+
+        if(!process_ranges.empty() && std::holds_alternative<uint32_t>(input_source))
+            return "Ranges cannot be used with device capture inputs";
+
+        if(realtime_latency.has_value() && !std::holds_alternative<uint32_t>(input_source))
+            return "Real-time mode can only be used with device capture inputs";
+
+        if(gop_decoders > 1 && !std::holds_alternative<std::filesystem::path>(input_source) && !batch_output.has_value())
+            return "Parallel decoding can only be used with video file inputs";
+
+        if(frame_cache.has_value() && (!std::holds_alternative<std::filesystem::path>(input_source) || batch_output.has_value()))
+            return "Frame caches can only be used with a single video file or image sequence input";
+
+        // Checkpoint segments are single files, which numbered image and shared memory outputs are not.
+        if(checkpoint_period.has_value() && output_target.has_value()
+            && (is_image_sequence(*output_target) || parse_shared_frame_target(output_target->string()).has_value()))
+            return "Checkpoints cannot be used with image sequence or shared memory outputs";
+
+        // Resuming is implemented as a range starting from the checkpoint.
+        if(!process_ranges.empty() && checkpoint_period.has_value())
+            return "Ranges cannot be used with checkpoints";
+
+        // Plans are split into segments using ranges.
+        if(plan_manifest.has_value())
+        {
+            if(batch_output.has_value() || !process_ranges.empty() || checkpoint_period.has_value())
+                return "Batches, ranges and checkpoints cannot be planned";
+
+            if(!std::holds_alternative<std::filesystem::path>(input_source) || !output_target.has_value())
+                return "Plans require both a video file input and an output";
+        }
+
+        if((worker_manifest.has_value() || merge_manifest.has_value()) && batch_output.has_value())
+            return "Manifests cannot be worked on or merged in batch mode";
+
+#ifndef PREVIEW_WINDOW
+        if(render_output)
+            return "Display options are unavailable, as the editor was built without preview window support";
+#endif
+
         // There will only be arguments left over if they didn't match any known options.
         if(!arguments.empty())
         {
@@ -84,6 +230,54 @@ namespace clt
         return std::nullopt;
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoIOConfiguration::configure_batch_job(
+        const std::filesystem::path& input,
+        const std::filesystem::path& output
+    )
+    {
+        LVK_ASSERT(batch_output.has_value());
+
+        batch_output.reset();
+        batch_inputs.clear();
+        batch_watch = false;
+
+        ArgQueue targets = {input.string(), output.string()};
+        if(auto error = parse_io_targets(targets); error.has_value())
+            return error;
+
+        if(!output_target.has_value())
+            return cv::format("Invalid batch output \'%s\'", output.string().c_str());
+
+        // Jobs share the console, which is reserved for the batch progress.
+        print_progress = false;
+        print_timings = false;
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoIOConfiguration::configure_segment_job(
+        const std::filesystem::path& input,
+        const std::filesystem::path& output,
+        const StreamRange& range
+    )
+    {
+        plan_manifest.reset();
+        worker_manifest.reset();
+        checkpoint_period.reset();
+
+        ArgQueue targets = {input.string(), output.string()};
+        if(auto error = parse_io_targets(targets); error.has_value())
+            return error;
+
+        process_ranges = {range};
+
+        return std::nullopt;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     std::optional<std::string> VideoIOConfiguration::parse_io_targets(ArgQueue& arguments)
@@ -97,7 +291,17 @@ namespace clt
 
         // Parse the input target
         std::optional<std::string> input_format;
-        if(std::filesystem::path path = input; path.has_filename() && path.has_extension())
+        if(auto raw_source = parse_raw_video_target(input); raw_source.has_value())
+        {
+            // Input is a Y4M or raw YUV file, pipe or stdin
+            input_source = *raw_source;
+        }
+        else if(auto shared_source = parse_shared_frame_target(input); shared_source.has_value())
+        {
+            // Input is a shared memory stream from another process
+            input_source = *shared_source;
+        }
+        else if(std::filesystem::path path = input; path.has_filename() && path.has_extension())
         {
             // Input is file path
             input_source = path;
@@ -122,7 +326,13 @@ namespace clt
             // Attempt to parse an output, this is optional so it can safely fail.
             // The output will always be a file path with the same format as the input video
             auto output = std::string(arguments.front());
-            if(std::filesystem::path path = output; path.has_filename() && path.has_extension())
+            if(parse_raw_video_target(output).has_value() || parse_shared_frame_target(output).has_value())
+            {
+                // Raw and shared memory outputs are written as-is, so do not need to match the input.
+                output_target = output;
+                arguments.pop_front();
+            }
+            else if(std::filesystem::path path = output; path.has_filename() && path.has_extension())
             {
                 // If the input was a video file, restrict the output to match the file format.
                 // This is not an encoding tool, so we can make things easier on ourselves here.
@@ -182,6 +392,53 @@ namespace clt
         return std::nullopt;
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoIOConfiguration::parse_benchmark(const std::string& specifier)
+    {
+        SyntheticSourceSettings settings;
+        if(!parse_video_specifier(specifier, settings.resolution, settings.framerate))
+        {
+            return cv::format(
+                "Invalid benchmark specifier, got \'%s\', expected WxH or WxH@FPS (e.g. 1920x1080@60)",
+                specifier.c_str()
+            );
+        }
+        input_source = settings;
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoIOConfiguration::parse_range(const std::string& specifier)
+    {
+        // Specifier is a comma separated list of START-END ranges, where END may be omitted.
+        std::stringstream ranges(specifier);
+        for(std::string range; std::getline(ranges, range, ',');)
+        {
+            const auto separator = range.find('-');
+            const auto start = parse_stream_position(range.substr(0, separator));
+
+            std::optional<StreamPosition> end;
+            if(separator != std::string::npos && separator + 1 < range.length())
+                end = parse_stream_position(range.substr(separator + 1));
+
+            if(separator == std::string::npos || !start.has_value() || (separator + 1 < range.length() && !end.has_value()))
+            {
+                return cv::format(
+                    "Invalid range \'%s\', expected START-END where each is a frame (f1200), "
+                    "seconds (90.5) or timecode (1:02:03.5)",
+                    range.c_str()
+                );
+            }
+
+            process_ranges.push_back({*start, end});
+        }
+
+        return std::nullopt;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoIOConfiguration::print_filter_manual(const std::string& filter) const
@@ -207,6 +464,13 @@ namespace clt
                      "device to read from.\n"
                   << "\t * Output is an optional video file path to which filtered video data is written. If paired "
                      "with a video file input, they must be of matching extensions. \n"
+                  << "\t * Either may also be \'-\' (or \'y4m:-\') for Y4M and \'yuv:-\' for raw I420 video over "
+                     "stdin/stdout, or a .y4m or .yuv file or named pipe. Console output moves to stderr when "
+                     "writing to stdout.\n"
+                  << "\t * Either may also be a .lvkv lossless intermediate, which is fast to write and seek, "
+                     "for handing video between lvk runs.\n"
+                  << "\t * Either may also be \'shm:NAME\' to pass frames between lvk processes through shared "
+                     "memory without copies. The output creates the stream, which the input then attaches to.\n"
                   << "\t * If no output is specified, or a device capture input is used, a display window will be used"
                      " to show output frames. This window can be closed using <escape>, ending all processing."
                   << "\n\n";
@@ -295,6 +559,177 @@ namespace clt
             }
         );
 
+        // Input Options
+
+        m_OptionParser.add_variable<std::string>(
+            "--raw",
+            "Used to specify the resolution and framerate (WxH@FPS) of header-less raw I420 input, "
+            "read from \'yuv:-\' or a .yuv file or named pipe.",
+            [this](const std::string& specifier)
+            {
+                RawVideoSettings settings;
+                if(!parse_video_specifier(specifier, settings.resolution, settings.framerate))
+                {
+                    m_ParserError = cv::format(
+                        "Invalid raw video specifier, got \'%s\', expected WxH or WxH@FPS (e.g. 1920x1080@60)",
+                        specifier.c_str()
+                    );
+                    return;
+                }
+                raw_settings = settings;
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--start",
+            "Starts processing at the given frame (f1200), seconds (90.5) or timecode (1:02:03.5) of the input, "
+            "seeking past everything before it.",
+            [this](const std::string& specifier)
+            {
+                m_RangeStart = parse_stream_position(specifier);
+                if(!m_RangeStart.has_value())
+                    m_ParserError = cv::format("Invalid start position \'%s\'", specifier.c_str());
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--end",
+            "Ends processing at the given frame, seconds or timecode of the input.",
+            [this](const std::string& specifier)
+            {
+                m_RangeEnd = parse_stream_position(specifier);
+                if(!m_RangeEnd.has_value())
+                    m_ParserError = cv::format("Invalid end position \'%s\'", specifier.c_str());
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--range",
+            "Processes only the given comma separated ranges of the input (e.g. 10:00-10:30,f90000-f91800), "
+            "which are joined in order in the output. May be repeated.",
+            [this](const std::string& specifier)
+            {
+                m_ParserError = parse_range(specifier);
+            }
+        );
+
+        // Decode Options
+
+        m_OptionParser.add_variable<int>(
+            "--decode-threads",
+            "Used to specify the number of threads used by each decoder (default chosen by the decoder).",
+            [this](const int threads) {
+                if(threads <= 0)
+                {
+                    m_ParserError = cv::format("Decoder thread count cannot be zero or negative, got \'%d\'", threads);
+                    return;
+                }
+                decoder_threads = threads;
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--decode-thread-type",
+            "Used to specify the decoder threading mode as either \'frame\', which adds a frame of latency per "
+            "thread, or \'slice\', which requires a codec and source that supports it. FFmpeg backend only.",
+            [this](const std::string& type) {
+#ifdef FFMPEG_BACKEND
+                if(type != "frame" && type != "slice")
+                {
+                    m_ParserError = cv::format(
+                        "Invalid decoder thread type, got \'%s\', expected \'frame\' or \'slice\'",
+                        type.c_str()
+                    );
+                    return;
+                }
+                decoder_thread_type = type;
+#else
+                m_ParserError = "Decoder thread types are only supported by the FFmpeg backend";
+#endif
+            }
+        );
+
+        m_OptionParser.add_variable<int>(
+            "--read-ahead",
+            "Used to specify the number of frames which are read ahead of the filters (default 15).",
+            [this](const int frames) {
+                if(frames <= 0)
+                {
+                    m_ParserError = cv::format("Read ahead cannot be zero or negative, got \'%d\' frames", frames);
+                    return;
+                }
+                read_ahead_frames = static_cast<uint32_t>(frames);
+            }
+        );
+
+        m_OptionParser.add_variable<int>(
+            "--gop-decoders",
+            "Decodes video files with the given number of decoders in parallel, each decoding separate "
+            "chunks of --gop-size frames. Suited to all-intra sources, or long-GOP sources when the chunks "
+            "span several GOPs, as every chunk starts with a seek.",
+            [this](const int decoders) {
+                if(decoders <= 0)
+                {
+                    m_ParserError = cv::format("Decoder count cannot be zero or negative, got \'%d\'", decoders);
+                    return;
+                }
+                gop_decoders = static_cast<uint32_t>(decoders);
+            }
+        );
+
+        m_OptionParser.add_variable<int>(
+            "--gop-size",
+            "Used to specify the number of frames in each chunk decoded by --gop-decoders (default 30).",
+            [this](const int frames) {
+                if(frames <= 0)
+                {
+                    m_ParserError = cv::format("GOP chunk size cannot be zero or negative, got \'%d\' frames", frames);
+                    return;
+                }
+                gop_chunk_frames = static_cast<uint32_t>(frames);
+            }
+        );
+
+        m_OptionParser.add_variable<double>(
+            "--sequence-fps",
+            "Used to specify the framerate of image sequence inputs, such as 'frames/%04d.png' (default 30).",
+            [this](const double framerate) {
+                if(framerate <= 0.0)
+                {
+                    m_ParserError = cv::format("Sequence framerate must be positive, got '%.2f'", framerate);
+                    return;
+                }
+                sequence_framerate = framerate;
+            }
+        );
+
+        m_OptionParser.add_variable<int>(
+            "--sequence-threads",
+            "Used to specify the number of threads decoding or encoding image sequences (default all cores).",
+            [this](const int threads) {
+                if(threads <= 0)
+                {
+                    m_ParserError = cv::format("Sequence threads cannot be zero or negative, got '%d'", threads);
+                    return;
+                }
+                sequence_threads = static_cast<uint32_t>(threads);
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--cache",
+            "Caches the decoded input frames in the given file, which later runs then map instead of decoding "
+            "the input. The cache is rebuilt if the input changes. Frames are stored uncompressed, so expect "
+            "around 3 bytes per pixel per frame.",
+            [this](const std::string& path) {
+#ifdef WIN32
+                m_ParserError = "Frame caches are not supported on Windows";
+#else
+                frame_cache = path;
+#endif
+            }
+        );
+
         // Output Options
         m_OptionParser.add_variable<int>(
             "-r",
@@ -327,6 +762,37 @@ namespace clt
             }
         );
 
+        m_OptionParser.add_variable<int>(
+            "-q",
+            "Used to specify the number of frames which may be queued for encoding (default 8). Larger queues "
+            "absorb spikes in encoding time at the cost of memory.",
+            [this](const int frames) {
+                if(frames <= 0)
+                {
+                    m_ParserError = cv::format(
+                        "Encoder queue size cannot be zero or negative, got \'%d\' frames",
+                        frames
+                    );
+                    return;
+                }
+                encoder_queue_size = static_cast<size_t>(frames);
+            }
+        );
+
+        m_OptionParser.add_variable<int>(
+            "--shm-slots",
+            "Used to specify the number of frame slots in a shared memory output (default 4), from 2 to 16. "
+            "More slots let the producer run further ahead of the consumer.",
+            [this](const int slots) {
+                if(slots < 2 || slots > 16)
+                {
+                    m_ParserError = cv::format("Shared memory slots must be between 2 and 16, got '%d'", slots);
+                    return;
+                }
+                shared_frame_slots = static_cast<uint32_t>(slots);
+            }
+        );
+
         m_OptionParser.add_switch(
             "-C",
             "Lists the fourcc codes of all available encoders.",
@@ -361,6 +827,42 @@ namespace clt
             }
         );
 
+        m_OptionParser.add_variable<double>(
+            "--checkpoint",
+            "Writes the output in segments of the given numeric amount of seconds, checkpointing the "
+            "job after each. Re-running the same command resumes from the last checkpoint.",
+            [this](double seconds) {
+                if(seconds <= 0)
+                {
+                    m_ParserError = cv::format(
+                        "Checkpoint period cannot be zero or negative, got \'%.2f\' seconds",
+                        seconds
+                    );
+                    return;
+                }
+
+                checkpoint_period = lvk::Time::Seconds(seconds);
+            }
+        );
+
+        m_OptionParser.add_variable<double>(
+            "--realtime",
+            "Used to specify a numeric latency target in milliseconds for device captures. Frames which "
+            "would exceed it are dropped as they are captured, so that the output keeps up with the device.",
+            [this](const double milliseconds) {
+                if(milliseconds <= 0)
+                {
+                    m_ParserError = cv::format(
+                        "Latency target cannot be zero or negative, got \'%.2f\' ms",
+                        milliseconds
+                    );
+                    return;
+                }
+
+                realtime_latency = lvk::Time::Milliseconds(milliseconds);
+            }
+        );
+
         // Logging Options
 
         m_OptionParser.add_variable<double>(
@@ -386,6 +888,13 @@ namespace clt
             &print_timings
         );
 
+        m_OptionParser.add_switch(
+            "-P",
+            "Samples hardware performance counters (cycles, instructions, LLC and branch misses) for each "
+            "filter and its internal stages. Only supported on Linux.",
+            &sample_counters
+        );
+
         m_OptionParser.add_variable<std::string>(
             "-L",
             "Turns on filter timing-data logging to the specified CSV filepath.",
@@ -402,6 +911,201 @@ namespace clt
                 log_target = path;
             }
         );
+
+        m_OptionParser.add_variable<std::string>(
+            "-M",
+            "Serves live metrics in the Prometheus text format on the given localhost port, or Unix socket path. "
+            "Metrics are refreshed with the logging update period.",
+            [this](const std::string& endpoint)
+            {
+                if(!endpoint.empty() && std::all_of(endpoint.begin(), endpoint.end(), [](int c){return std::isdigit(c);}))
+                {
+                    const int port = std::stoi(endpoint.substr(0, 6));
+                    if(port <= 0 || port > 65535)
+                    {
+                        m_ParserError = cv::format("Invalid metrics port, got \'%s\'", endpoint.c_str());
+                        return;
+                    }
+                    metrics_port = static_cast<uint16_t>(port);
+                }
+                else metrics_socket = endpoint;
+            }
+        );
+
+        // Benchmark Options
+
+        m_OptionParser.add_variable<std::string>(
+            "--benchmark",
+            "Benchmarks the filter chain on a synthetic video of the given resolution and framerate (WxH@FPS), "
+            "which replaces the input and output. A JSON report of the throughput, filter latencies, CPU "
+            "utilisation and peak memory is printed once finished.",
+            [this](const std::string& specifier)
+            {
+                m_ParserError = parse_benchmark(specifier);
+            }
+        );
+
+        m_OptionParser.add_variable<int>(
+            "--benchmark-frames",
+            "Used to specify the number of synthetic frames to process when benchmarking.",
+            [this](const int frames) {
+                if(frames <= 0)
+                {
+                    m_ParserError = cv::format(
+                        "Benchmark frame count cannot be zero or negative, got \'%d\' frames",
+                        frames
+                    );
+                    return;
+                }
+                benchmark_frames = static_cast<uint32_t>(frames);
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--benchmark-report",
+            "Writes the benchmark report to the specified JSON filepath instead of the console.",
+            [this](const std::string& path_arg)
+            {
+                const std::filesystem::path path = path_arg;
+                if(path.extension() != ".json")
+                {
+                    m_ParserError = cv::format(
+                        "Invalid benchmark report target, got file type %s, expected \'.json\'",
+                        path.extension().string().c_str()
+                    );
+                }
+                benchmark_report = path;
+            }
+        );
+
+        // Batch Options
+
+        m_OptionParser.add_variable<std::string>(
+            "--batch",
+            "Processes every input in a batch, writing each to the given output pattern. All positional "
+            "arguments are then inputs, which may be paths, quoted globs (e.g. \'clips/*.mp4\') or .txt files "
+            "listing one path per line. The pattern may use {dir}, {name} and {ext} of the input, for "
+            "example \'out/{name}_stable{ext}\'.",
+            [this](const std::string& pattern)
+            {
+                if(pattern.find("{name}") == std::string::npos)
+                {
+                    m_ParserError = cv::format(
+                        "Invalid batch output pattern, got \'%s\', expected a pattern containing {name}",
+                        pattern.c_str()
+                    );
+                    return;
+                }
+                batch_output = pattern;
+            }
+        );
+
+        m_OptionParser.add_variable<int>(
+            "-j",
+            "Used to specify the number of batch inputs to process concurrently (default 1).",
+            [this](const int jobs) {
+                if(jobs <= 0)
+                {
+                    m_ParserError = cv::format("Batch job count cannot be zero or negative, got \'%d\'", jobs);
+                    return;
+                }
+                batch_jobs = static_cast<uint32_t>(jobs);
+            }
+        );
+
+        m_OptionParser.add_variable<int>(
+            "--cores",
+            "Used to specify the number of CPU cores shared by all batch jobs (default all).",
+            [this](const int cores) {
+                if(cores <= 0)
+                {
+                    m_ParserError = cv::format("Batch core budget cannot be zero or negative, got \'%d\'", cores);
+                    return;
+                }
+                batch_cores = static_cast<uint32_t>(cores);
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--batch-report",
+            "Writes the result of every batch job to the specified JSON filepath.",
+            [this](const std::string& path_arg)
+            {
+                const std::filesystem::path path = path_arg;
+                if(path.extension() != ".json")
+                {
+                    m_ParserError = cv::format(
+                        "Invalid batch report target, got file type %s, expected \'.json\'",
+                        path.extension().string().c_str()
+                    );
+                }
+                batch_report = path;
+            }
+        );
+
+        m_OptionParser.add_switch(
+            "--watch",
+            "Runs batch mode as a daemon, treating every input as a directory to watch. Video files already "
+            "in the directories without an up to date output, and any which arrive later, are processed "
+            "by a pool of -j warm jobs that share one OpenCL context. Runs until interrupted.",
+            &batch_watch
+        );
+
+        // Distributed Options
+
+        m_OptionParser.add_variable<std::string>(
+            "--plan",
+            "Splits the job into segments instead of processing it, writing a JSON manifest to the given "
+            "path. The segments can then be processed by any number of --worker processes sharing its "
+            "directory, and joined into the output with --merge.",
+            [this](const std::string& path_arg)
+            {
+                const std::filesystem::path path = path_arg;
+                if(path.extension() != ".json")
+                {
+                    m_ParserError = cv::format(
+                        "Invalid plan manifest target, got file type %s, expected \'.json\'",
+                        path.extension().string().c_str()
+                    );
+                }
+                plan_manifest = path;
+            }
+        );
+
+        m_OptionParser.add_variable<double>(
+            "--segment-length",
+            "Used to specify the numeric amount of seconds of input in each planned segment (default 60).",
+            [this](const double seconds) {
+                if(seconds <= 0)
+                {
+                    m_ParserError = cv::format(
+                        "Segment length cannot be zero or negative, got \'%.2f\' seconds",
+                        seconds
+                    );
+                    return;
+                }
+                plan_segment_length = lvk::Time::Seconds(seconds);
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--worker",
+            "Processes unclaimed segments of the given manifest until none are left. No input or output "
+            "is specified, they are taken from the manifest.",
+            [this](const std::string& path)
+            {
+                worker_manifest = path;
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--merge",
+            "Joins the processed segments of the given manifest into its output.",
+            [this](const std::string& path)
+            {
+                merge_manifest = path;
+            }
+        );
     }
 
 //---------------------------------------------------------------------------------------------------------------------
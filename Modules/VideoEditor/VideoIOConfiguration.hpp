@@ -25,37 +25,107 @@
 
 #include "OptionParser.hpp"
 #include "FilterParser.hpp"
+#include "SyntheticSource.hpp"
+#include "RawVideoIO.hpp"
+#include "ImageSequenceIO.hpp"
+#include "SharedFrameIO.hpp"
 
 namespace clt
 {
 
+    // A position within the input, either as a time or a frame index.
+    struct StreamPosition
+    {
+        double value = 0.0;
+        bool is_frame = false;
+
+        lvk::Time to_time(const double framerate) const;
+    };
+
+    struct StreamRange
+    {
+        StreamPosition start;
+        std::optional<StreamPosition> end;
+    };
+
+
     struct VideoIOConfiguration
     {
         // Input / Process Settings
-        std::variant<std::monostate, std::filesystem::path, uint32_t> input_source;
+        std::variant<std::monostate, std::filesystem::path, uint32_t, SyntheticSourceSettings, RawVideoSource, SharedFrameSource> input_source;
+        std::optional<RawVideoSettings> raw_settings;
         std::vector<std::shared_ptr<lvk::VideoFilter>> filter_chain;
+        std::vector<StreamRange> process_ranges;
+
+        // Decode Settings
+        int decoder_threads = 0;                         // Zero leaves it to the decoder
+        std::optional<std::string> decoder_thread_type; // 'frame' or 'slice', FFmpeg backend only
+        uint32_t read_ahead_frames = 15;
+        uint32_t gop_decoders = 1;                       // Parallel decoder instances for video files
+        uint32_t gop_chunk_frames = 30;
+        double sequence_framerate = 30.0;                // Image sequences carry no timing
+        uint32_t sequence_threads = 0;                   // Zero uses all hardware threads
+        std::optional<std::filesystem::path> frame_cache; // Decoded frames, built on the first run
 
         // Output Settings
         std::optional<std::filesystem::path> output_target;
         std::optional<double> output_framerate;
         std::optional<int> output_codec;
+        size_t encoder_queue_size = 8;
+        uint32_t shared_frame_slots = 4;                 // Frame slots of shared memory outputs
 
         bool render_output = false;
         std::optional<lvk::Time> render_period;
+        std::optional<lvk::Time> realtime_latency; // Drops device frames which would exceed it
 
         // Runtime Settings
         bool print_progress = true;
         bool print_timings = false;
+        bool sample_counters = false;
         std::optional<std::filesystem::path> log_target;
+        std::optional<lvk::Time> checkpoint_period;
 
         lvk::Time update_period = lvk::Time::Seconds(0.5);
 
+        // Metrics Settings
+        std::optional<uint16_t> metrics_port;
+        std::optional<std::filesystem::path> metrics_socket;
+
+        // Benchmark Settings
+        uint32_t benchmark_frames = 600;
+        std::optional<std::filesystem::path> benchmark_report;
+
+        // Batch Settings
+        std::optional<std::string> batch_output; // Output path pattern, enables batch mode
+        std::vector<std::string> batch_inputs;   // Input paths, globs or list files
+        uint32_t batch_jobs = 1;
+        uint32_t batch_cores = 0;                // Zero uses all hardware threads
+        std::optional<std::filesystem::path> batch_report;
+        bool batch_watch = false;                // Inputs are directories watched for new files
+
+        // Distributed Settings
+        std::optional<std::filesystem::path> plan_manifest;   // Splits the job into segments
+        std::optional<std::filesystem::path> worker_manifest; // Processes segments of a plan
+        std::optional<std::filesystem::path> merge_manifest;  // Joins the processed segments
+        lvk::Time plan_segment_length = lvk::Time::Seconds(60);
+
     public:
 
         VideoIOConfiguration();
 
         std::optional<std::string> from_command_line(const int argc, char* argv[]);
 
+        std::optional<std::string> configure_batch_job(
+            const std::filesystem::path& input,
+            const std::filesystem::path& output
+        );
+
+        std::optional<std::string> configure_segment_job(
+            const std::filesystem::path& input,
+            const std::filesystem::path& output,
+            const StreamRange& range
+        );
+
         void print_filter_manual(const std::string& filter) const;
 
         void print_manual() const;
@@ -70,11 +140,16 @@ namespace clt
 
         std::optional<std::string> parse_profile(ArgQueue& arguments);
 
+        std::optional<std::string> parse_benchmark(const std::string& specifier);
+
+        std::optional<std::string> parse_range(const std::string& specifier);
+
     private:
         OptionsParser m_OptionParser;
         FilterParser m_FilterParser;
 
         std::optional<std::string> m_ParserError;
+        std::optional<StreamPosition> m_RangeStart, m_RangeEnd;
     };
 
 }
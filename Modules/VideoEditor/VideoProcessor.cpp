@@ -18,7 +18,11 @@
 #include "VideoProcessor.hpp"
 
 #include <type_traits>
+#include <algorithm>
+#include <limits>
+#include <sstream>
 #include <utility>
+#include <thread>
 
 namespace clt
 {
@@ -26,11 +30,40 @@ namespace clt
 
     constexpr size_t FILTER_TIMING_SAMPLES = 300;
     constexpr const char* RENDER_WINDOW_NAME = "LVK Output";
+    const lvk::Time PREVIEW_REFRESH_PERIOD = lvk::Time::Timestep(30.0);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double to_megabytes(const size_t bytes)
+    {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool writes_to_stdout(const VideoIOConfiguration& configuration)
+    {
+        if(!configuration.output_target.has_value())
+            return false;
+
+        const auto raw_target = parse_raw_video_target(configuration.output_target->string());
+        return raw_target.has_value() && raw_target->path == "-";
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint32_t sequence_threads(const VideoIOConfiguration& configuration)
+    {
+        return configuration.sequence_threads > 0
+            ? configuration.sequence_threads
+            : std::max(std::thread::hardware_concurrency(), 1u);
+    }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     VideoProcessor::VideoProcessor(VideoIOConfiguration configuration)
-        : m_Configuration(std::move(configuration))
+        : m_Configuration(std::move(configuration)),
+          m_ConsoleLogger(writes_to_stdout(m_Configuration) ? std::cerr : std::cout)
     {}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -44,15 +77,61 @@ namespace clt
 
             if constexpr(std::is_same_v<source_type, std::filesystem::path>)
             {
+                m_DeviceCapture = false;
+
+                // A valid frame cache replaces the decoder entirely, otherwise it is rebuilt.
+                if(m_Configuration.frame_cache.has_value()
+                    && !m_CacheInputStream.open(*m_Configuration.frame_cache, frame_cache_key(source)).has_value())
+                    return;
+
+                if(is_lossless_video(source))
+                {
+                    input_error = m_LosslessInputStream.open(source);
+                    return;
+                }
+
+                if(is_image_sequence(source))
+                {
+                    input_error = m_SequenceInputStream.open(
+                        source,
+                        m_Configuration.sequence_framerate,
+                        sequence_threads(m_Configuration),
+                        m_Configuration.read_ahead_frames
+                    );
+                    return;
+                }
+
+                if(m_Configuration.gop_decoders > 1)
+                {
+                    input_error = m_ParallelInputStream.open(
+                        source,
+                        m_Configuration.gop_decoders,
+                        m_Configuration.gop_chunk_frames,
+                        m_Configuration.decoder_threads
+                    );
+                    return;
+                }
+#ifdef FFMPEG_BACKEND
+                int thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+                if(m_Configuration.decoder_thread_type.has_value())
+                    thread_type = *m_Configuration.decoder_thread_type == "frame" ? FF_THREAD_FRAME : FF_THREAD_SLICE;
+
+                input_error = m_FFmpegInputStream.open(source, m_Configuration.decoder_threads, thread_type);
+#else
                 std::vector<int> properties = {
                     cv::CAP_PROP_HW_ACCELERATION, 1,
                     cv::CAP_PROP_HW_ACCELERATION_USE_OPENCL, 1
                 };
+                if(m_Configuration.decoder_threads > 0)
+                {
+                    properties.push_back(cv::CAP_PROP_N_THREADS);
+                    properties.push_back(m_Configuration.decoder_threads);
+                }
 
-                m_DeviceCapture = false;
                 m_InputStream = cv::VideoCapture(source.string(), cv::CAP_FFMPEG, properties);
                 if(!m_InputStream.isOpened())
                     input_error = cv::format("Failed to open the input video \'%s\'", source.string().c_str());
+#endif
             }
             else if constexpr(std::is_same_v<source_type, uint32_t>)
             {
@@ -61,6 +140,24 @@ namespace clt
                 if(!m_InputStream.isOpened())
                     input_error = cv::format("Failed to capture device \'%u\'", source);
             }
+            else if constexpr(std::is_same_v<source_type, SyntheticSourceSettings>)
+            {
+                auto settings = source;
+                settings.frame_count = m_Configuration.benchmark_frames;
+
+                m_DeviceCapture = false;
+                m_SyntheticSource.emplace(settings);
+            }
+            else if constexpr(std::is_same_v<source_type, RawVideoSource>)
+            {
+                m_DeviceCapture = false;
+                input_error = m_RawInputStream.open(source, m_Configuration.raw_settings);
+            }
+            else if constexpr(std::is_same_v<source_type, SharedFrameSource>)
+            {
+                m_DeviceCapture = false;
+                input_error = m_SharedInputStream.open(source);
+            }
             else input_error = "No input source was specified!";
         },
         m_Configuration.input_source);
@@ -68,11 +165,34 @@ namespace clt
         if(input_error.has_value())
             return input_error;
 
+        // When benchmarking, keep the timings of every frame for the report.
+        const size_t timing_samples = m_SyntheticSource.has_value()
+            ? m_SyntheticSource->settings().frame_count : FILTER_TIMING_SAMPLES;
+
+        if(m_SyntheticSource.has_value())
+        {
+            m_Processor.set_timing_samples(timing_samples);
+            m_FrameTimer.set_history_size(timing_samples);
+        }
+
+        // Enable hardware performance counters
+        if(m_Configuration.sample_counters)
+        {
+            lvk::PerformanceCounters::SetEnabled(true);
+            if(!lvk::PerformanceCounters::IsSupported())
+                return "Hardware performance counters are not available, check perf_event_paranoid";
+        }
+
+        // Track filter allocations whenever filter statistics are being reported.
+        if(m_Configuration.print_timings || m_Configuration.log_target.has_value() || m_SyntheticSource.has_value())
+            lvk::TrackingAllocator::Install();
+
         // Configure the filter
+        m_Processor.set_stream_buffer_size(m_Configuration.read_ahead_frames);
         m_Processor.reconfigure([&](lvk::CompositeFilterSettings& settings){
             for(auto& filter : m_Configuration.filter_chain)
             {
-                filter->set_timing_samples(FILTER_TIMING_SAMPLES);
+                filter->set_timing_samples(timing_samples);
                 settings.filter_chain.push_back(filter);
             }
         });
@@ -87,6 +207,24 @@ namespace clt
             m_DataLogger.emplace(m_DataLogStream);
         }
 
+        // Start metrics exporter
+        std::optional<std::string> exporter_error;
+        if(m_Configuration.metrics_port.has_value())
+            exporter_error = m_MetricsExporter.listen(*m_Configuration.metrics_port);
+        else if(m_Configuration.metrics_socket.has_value())
+            exporter_error = m_MetricsExporter.listen(*m_Configuration.metrics_socket);
+
+        if(exporter_error.has_value())
+            return exporter_error;
+
+        // Filters can only be inspected safely from the thread they run on.
+        const bool log_counters = m_Configuration.print_timings || m_DataLogger.has_value();
+        if(m_MetricsExporter.is_running() || (log_counters && lvk::PerformanceCounters::IsEnabled()))
+        {
+            m_FilterMetricsRequested = true;
+            m_Processor.set_stream_observer([this](){publish_filter_metrics();});
+        }
+
         return std::nullopt;
     }
 
@@ -97,6 +235,98 @@ namespace clt
         if(!m_Configuration.output_target.has_value())
             return "Could not create output stream, no target was specified";
 
+        const auto target = output_path();
+
+        // Shared memory outputs are downloaded straight into the consumer's frame slots.
+        if(const auto shared_target = parse_shared_frame_target(target.string()))
+        {
+            const auto error = m_SharedOutputStream.open(
+                *shared_target,
+                frame_size,
+                m_Configuration.output_framerate.value_or(input_framerate()),
+                m_Configuration.shared_frame_slots
+            );
+            if(error.has_value())
+                return error;
+
+            m_OutputWriter.set_queue_capacity(m_Configuration.encoder_queue_size);
+            m_OutputWriter.start([this](const lvk::Frame& frame){
+                m_SharedOutputStream.write(frame);
+            });
+
+            return std::nullopt;
+        }
+
+        // Lossless intermediates compress their slices in parallel on the writer thread.
+        if(is_lossless_video(target))
+        {
+            const auto error = m_LosslessOutputStream.open(
+                target,
+                frame_size,
+                m_Configuration.output_framerate.value_or(input_framerate())
+            );
+            if(error.has_value())
+                return error;
+
+            m_OutputWriter.set_queue_capacity(m_Configuration.encoder_queue_size);
+            m_OutputWriter.start([this](const lvk::Frame& frame){
+                m_LosslessOutputStream.write(frame);
+            });
+
+            return std::nullopt;
+        }
+
+        // Image sequences are encoded on their own pool, behind the output writer.
+        if(is_image_sequence(target))
+        {
+            const auto error = m_SequenceOutputStream.open(
+                target,
+                sequence_threads(m_Configuration),
+                static_cast<uint32_t>(m_Configuration.encoder_queue_size)
+            );
+            if(error.has_value())
+                return error;
+
+            m_OutputWriter.set_queue_capacity(m_Configuration.encoder_queue_size);
+            m_OutputWriter.start([this](const lvk::Frame& frame){
+                m_SequenceOutputStream.write(frame);
+            });
+
+            return std::nullopt;
+        }
+
+        // Y4M and raw YUV targets bypass the encoder entirely.
+        if(const auto raw_target = parse_raw_video_target(target.string()))
+        {
+            const auto framerate = m_Configuration.output_framerate.value_or(input_framerate());
+            if(auto error = m_RawOutputStream.open(*raw_target, frame_size, framerate); error.has_value())
+                return error;
+
+            m_OutputWriter.set_queue_capacity(m_Configuration.encoder_queue_size);
+            m_OutputWriter.start([this](const lvk::Frame& frame){
+                m_RawOutputStream.write(frame);
+            });
+
+            return std::nullopt;
+        }
+
+#ifdef FFMPEG_BACKEND
+        // Encode from YUV, re-using the input's codec unless the user chose another.
+        const auto error = m_FFmpegOutputStream.open(
+            target,
+            frame_size,
+            m_Configuration.output_framerate.value_or(input_framerate()),
+            m_Configuration.output_codec,
+            static_cast<AVCodecID>(input_codec())
+        );
+        if(error.has_value())
+            return error;
+
+        m_OutputWriter.set_queue_capacity(m_Configuration.encoder_queue_size);
+        m_OutputWriter.start([this](const lvk::Frame& frame){
+            m_FFmpegOutputStream.write(frame);
+        });
+#else
         try {
             std::vector<int> properties = {
                 cv::VideoWriterProperties::VIDEOWRITER_PROP_HW_ACCELERATION, 1,
@@ -104,14 +334,10 @@ namespace clt
             };
 
             m_OutputStream = cv::VideoWriter(
-                m_Configuration.output_target->string(),
+                target.string(),
                 cv::CAP_FFMPEG,
-                m_Configuration.output_codec.value_or(
-                    static_cast<int>(m_InputStream.get(cv::CAP_PROP_FOURCC))
-                ),
-                m_Configuration.output_framerate.value_or(
-                    std::max(m_InputStream.get(cv::CAP_PROP_FPS), 1.0)
-                ),
+                m_Configuration.output_codec.value_or(input_codec()),
+                m_Configuration.output_framerate.value_or(input_framerate()),
                 frame_size,
                 properties
             );
@@ -129,13 +355,165 @@ namespace clt
         {
             return cv::format(
                 "Failed to create an output stream at \'%s\'",
-                m_Configuration.output_target->string().c_str()
+                target.string().c_str()
+            );
+        }
+
+        // The VideoWriter only accepts BGR frames, which raw YUV inputs will not be.
+        m_OutputWriter.set_queue_capacity(m_Configuration.encoder_queue_size);
+        m_OutputWriter.start([this, bgr_buffer = lvk::Frame()](const lvk::Frame& frame) mutable {
+            if(frame.format != lvk::VideoFrame::BGR && frame.format != lvk::VideoFrame::UNKNOWN)
+            {
+                frame.reformatTo(bgr_buffer, lvk::VideoFrame::BGR);
+                m_OutputStream.write(bgr_buffer);
+            }
+            else m_OutputStream.write(frame);
+        });
+#endif
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoProcessor::close_output_stream()
+    {
+        // Drain any frames still waiting to be encoded.
+        auto error = m_OutputWriter.finish();
+
+        m_SequenceOutputStream.close();
+        m_SharedOutputStream.close();
+        m_LosslessOutputStream.close();
+        if(!error.has_value())
+            error = m_SequenceOutputStream.error();
+
+        m_OutputStream.release();
+        m_RawOutputStream.close();
+#ifdef FFMPEG_BACKEND
+        m_FFmpegOutputStream.close();
+#endif
+
+        return error;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::filesystem::path VideoProcessor::output_path() const
+    {
+        LVK_ASSERT(m_Configuration.output_target.has_value());
+
+        // With checkpoints, the output is written one segment at a time.
+        if(m_Checkpoint.has_value())
+            return Checkpoint::SegmentPath(*m_Configuration.output_target, m_Checkpoint->segments.size());
+
+        return *m_Configuration.output_target;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoProcessor::initialize_checkpoint()
+    {
+        const auto* input_path = std::get_if<std::filesystem::path>(&m_Configuration.input_source);
+        const auto* raw_source = std::get_if<RawVideoSource>(&m_Configuration.input_source);
+
+        const bool file_input = input_path != nullptr || (raw_source != nullptr && raw_source->path != "-");
+        if(!file_input || !m_Configuration.output_target.has_value() || writes_to_stdout(m_Configuration))
+            return "Checkpoints require both the input and output to be files";
+
+        const auto input = input_path != nullptr ? input_path->string() : raw_source->path.string();
+        const auto output = m_Configuration.output_target->string();
+        const auto checkpoint_path = Checkpoint::PathFor(*m_Configuration.output_target);
+
+        auto checkpoint = Checkpoint::Load(checkpoint_path);
+        if(!checkpoint.has_value())
+        {
+            m_Checkpoint.emplace();
+            m_Checkpoint->input = input;
+            m_Checkpoint->output = output;
+            return std::nullopt;
+        }
+
+        if(checkpoint->input != input || checkpoint->output != output)
+        {
+            return cv::format(
+                "Checkpoint \'%s\' belongs to a different job, delete it to start over",
+                checkpoint_path.string().c_str()
             );
         }
 
+        for(const auto& segment : checkpoint->segments)
+        {
+            if(!std::filesystem::exists(segment.path))
+            {
+                return cv::format(
+                    "Checkpoint segment \'%s\' is missing, delete \'%s\' to start over",
+                    segment.path.string().c_str(),
+                    checkpoint_path.string().c_str()
+                );
+            }
+        }
+
+        // Resume with a range starting after the last completed segment. Its pre-roll lets
+        // the tracker, smoother and frame queues rebuild their state from the input itself.
+        if(!checkpoint->segments.empty())
+        {
+            m_Configuration.process_ranges.push_back({
+                StreamPosition{checkpoint->resume_position().seconds(), false},
+                std::nullopt
+            });
+        }
+        m_Checkpoint = std::move(checkpoint);
+
         return std::nullopt;
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoProcessor::save_checkpoint(const lvk::Time& segment_end)
+    {
+        LVK_ASSERT(m_Checkpoint.has_value());
+
+        // The segment must be complete on disk before the checkpoint can refer to it.
+        if(auto error = close_output_stream(); error.has_value())
+            return error;
+
+        m_Checkpoint->segments.push_back({output_path(), segment_end});
+        return m_Checkpoint->save(Checkpoint::PathFor(*m_Configuration.output_target));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double VideoProcessor::input_framerate() const
+    {
+        if(m_SyntheticSource.has_value())
+            return m_SyntheticSource->settings().framerate;
+
+        if(m_CacheInputStream.is_open())
+            return m_CacheInputStream.framerate();
+
+        if(m_RawInputStream.is_open())
+            return m_RawInputStream.framerate();
+
+        if(m_ParallelInputStream.is_open())
+            return m_ParallelInputStream.framerate();
+
+        if(m_SequenceInputStream.is_open())
+            return m_SequenceInputStream.framerate();
+
+        if(m_SharedInputStream.is_open())
+            return m_SharedInputStream.framerate();
+
+        if(m_LosslessInputStream.is_open())
+            return m_LosslessInputStream.framerate();
+
+#ifdef FFMPEG_BACKEND
+        if(m_FFmpegInputStream.is_open())
+            return m_FFmpegInputStream.framerate();
+#endif
+
+        return std::max(m_InputStream.get(cv::CAP_PROP_FPS), 1.0);
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoProcessor::stop()
@@ -153,94 +531,504 @@ namespace clt
         if(runtime_error.has_value())
             return runtime_error;
 
-        // Create output window, making sure its resizable
+        if(m_Configuration.checkpoint_period.has_value())
+        {
+            runtime_error = initialize_checkpoint();
+            if(runtime_error.has_value())
+                return runtime_error;
+        }
+
+        // Build the frame cache during a full pass of the input, so that later runs can skip decoding.
+        if(m_Configuration.frame_cache.has_value() && !m_CacheInputStream.is_open() && m_Configuration.process_ranges.empty())
+        {
+            runtime_error = m_CacheOutputStream.open(
+                *m_Configuration.frame_cache,
+                frame_cache_key(std::get<std::filesystem::path>(m_Configuration.input_source)),
+                input_framerate(),
+                input_codec()
+            );
+            if(runtime_error.has_value())
+                return runtime_error;
+        }
+
+#ifdef PREVIEW_WINDOW
+        // Create output window, which refreshes no faster than any locked framerate.
         if(m_Configuration.render_output)
-            cv::namedWindow(RENDER_WINDOW_NAME, cv::WINDOW_NORMAL | cv::WINDOW_KEEPRATIO);
+        {
+            m_Preview.open(
+                RENDER_WINDOW_NAME,
+                m_Configuration.render_period.has_value()
+                    ? std::max(*m_Configuration.render_period, PREVIEW_REFRESH_PERIOD)
+                    : PREVIEW_REFRESH_PERIOD
+            );
+        }
+#endif
 
+        const auto start_usage = ResourceUsage::Query();
         m_FrameTimer.start();
         m_ProcessTimer.start();
         lvk::Time last_update_time;
 
-        // Run the processor filter
-        m_Terminate = false;
-        m_Processor.stream(
-            m_InputStream,
-            [&, this](lvk::Frame& frame) {
-                // Write output
-                if(m_Configuration.output_target.has_value())
-                {
-                    // Lazily initialize the output stream on first output frame
-                    if(!m_OutputStream.isOpened())
-                    {
-                        runtime_error = initialize_output_stream(frame.size());
-                        if(runtime_error.has_value())
-                            return true;
-                    }
+        const auto output_callback = [&, this](lvk::Frame& frame) {
+            // Measure the capture to output latency of real-time frames.
+            if(m_DeviceCapture && m_Configuration.realtime_latency.has_value())
+            {
+                const auto latency = static_cast<uint64_t>((m_ProcessTimer.elapsed() - lvk::Time(frame.timestamp)).nanoseconds());
+                m_OutputLatency = latency;
+                m_PeakLatency = std::max(m_PeakLatency.load(), latency);
+            }
 
-                    m_OutputStream.write(frame);
-                }
+            // Display output, this comes first as the frame is handed off to the writer.
+            // The preview copies what it needs, and does its drawing on its own thread.
+            bool close_display = false;
+#ifdef PREVIEW_WINDOW
+            if(m_Configuration.render_output)
+                close_display = !m_Preview.submit(frame);
+#endif
 
-                // Display output
-                if(m_Configuration.render_output)
+            // Write output
+            if(m_Configuration.output_target.has_value())
+            {
+                // Close off the current segment once it spans the checkpoint period. The
+                // checkpoint resumes halfway between frames, to be robust against rounding.
+                if(m_Checkpoint.has_value() && m_OutputWriter.is_running()
+                    && lvk::Time(frame.timestamp) >= m_SegmentStart + *m_Configuration.checkpoint_period)
                 {
-                    cv::imshow(RENDER_WINDOW_NAME, frame);
-
-                    // Close display if escape is pressed, also note that
-                    // the poll event is required to update the window.
-                    if(const auto key = cv::pollKey(); key == 27)
-                    {
-                        m_Configuration.render_output = false;
-                        cv::destroyAllWindows();
-
-                        // If the input is a device capture or there is no output path, then
-                        // we consider the display to the output. So closing the window should
-                        // also terminate the processing. This is so that we can decide when to
-                        // end indefinite device capture streams, and to avoid accidentally
-                        // leaving the processor running in the background indefinitely.
-                        return m_DeviceCapture || !m_Configuration.output_target.has_value();
-                    }
+                    runtime_error = save_checkpoint(lvk::Time((m_LastOutputTimestamp + frame.timestamp) / 2));
+                    if(runtime_error.has_value())
+                        return true;
                 }
 
-                // Update the frame timer
-                if(m_Configuration.render_output && m_Configuration.render_period.has_value())
+                // Lazily initialize the output stream on first output frame
+                if(!m_OutputWriter.is_running())
                 {
-                    // If we are displaying the output at a fixed frequency,
-                    // then we need to wait to match the user's timestep here.
-                    m_FrameTimer.tick(*m_Configuration.render_period);
+                    runtime_error = initialize_output_stream(frame.size());
+                    if(runtime_error.has_value())
+                        return true;
+
+                    m_SegmentStart = lvk::Time(frame.timestamp);
                 }
-                else m_FrameTimer.tick();
+                m_LastOutputTimestamp = frame.timestamp;
 
-                // Run all update procedures (logging etc.)
-                const auto elapsed_time = m_ProcessTimer.elapsed();
-                if(last_update_time.is_zero() || elapsed_time > last_update_time + m_Configuration.update_period)
+                // Encoding happens on the writer thread, so we only block here if it falls behind.
+                if(!m_OutputWriter.write(std::move(frame)))
                 {
-                    last_update_time = elapsed_time;
-                    write_to_loggers();
+                    runtime_error = m_OutputWriter.finish();
+                    return true;
                 }
+            }
 
-                return m_Terminate;
-            },
-            m_Configuration.print_timings || m_DataLogger.has_value()
-        );
+            // Close display if escape is pressed
+            if(close_display)
+            {
+                m_Configuration.render_output = false;
+#ifdef PREVIEW_WINDOW
+                m_Preview.close();
+#endif
+
+                // If the input is a device capture or there is no output path, then
+                // we consider the display to the output. So closing the window should
+                // also terminate the processing. This is so that we can decide when to
+                // end indefinite device capture streams, and to avoid accidentally
+                // leaving the processor running in the background indefinitely.
+                return m_DeviceCapture || !m_Configuration.output_target.has_value();
+            }
+
+            // Update the frame timer
+            if(m_Configuration.render_output && m_Configuration.render_period.has_value())
+            {
+                // If we are displaying the output at a fixed frequency,
+                // then we need to wait to match the user's timestep here.
+                m_FrameTimer.tick(*m_Configuration.render_period);
+            }
+            else m_FrameTimer.tick();
+
+            // Run all update procedures (logging etc.)
+            const auto elapsed_time = m_ProcessTimer.elapsed();
+            if(last_update_time.is_zero() || elapsed_time > last_update_time + m_Configuration.update_period)
+            {
+                last_update_time = elapsed_time;
+                write_to_loggers();
+            }
+
+            return m_Terminate;
+        };
+
+        // Always profile benchmarks so that GPU work is attributed to the right frame.
+        const bool profile = m_SyntheticSource.has_value() || m_Configuration.print_timings || m_DataLogger.has_value();
+
+        // Run the processor filter, ranges are streamed separately but make up one job.
+        m_Terminate = false;
+        m_Processor.reset_stream_status();
+        if(m_Configuration.process_ranges.empty())
+        {
+            m_Processor.stream(
+                [this](lvk::Frame& frame){return read_input(frame);},
+                output_callback,
+                profile
+            );
+        }
+        else if(auto range_error = process_ranges(output_callback, profile); range_error.has_value())
+            runtime_error = range_error;
+
+        // A sequence with an unreadable image ends early rather than skipping the frame.
+        if(m_SequenceInputStream.is_open() && !runtime_error.has_value())
+            runtime_error = m_SequenceInputStream.error();
+
+        if(m_SharedInputStream.is_open() && !runtime_error.has_value())
+            runtime_error = m_SharedInputStream.error();
+
+        if(m_Checkpoint.has_value())
+        {
+            // Checkpoint whatever was written, so that an interrupted job can be resumed. Once
+            // complete, the segments are joined into the output and the checkpoint is removed.
+            if(m_OutputWriter.is_running() && !runtime_error.has_value())
+            {
+                const auto segment_end = lvk::Time(m_LastOutputTimestamp) + lvk::Time::Timestep(input_framerate()) * 0.5;
+                runtime_error = save_checkpoint(segment_end);
+            }
+
+            if(!m_Terminate && !runtime_error.has_value())
+            {
+                runtime_error = merge_segments(m_Checkpoint->segments, *m_Configuration.output_target);
+                if(!runtime_error.has_value())
+                    std::filesystem::remove(Checkpoint::PathFor(*m_Configuration.output_target));
+            }
+        }
+
+        // An unfinished cache would be missing frames, so it is discarded.
+        m_CacheOutputStream.close();
+#ifdef PREVIEW_WINDOW
+        m_Preview.close();
+#endif
+
+        if(auto writer_error = close_output_stream(); writer_error.has_value() && !runtime_error.has_value())
+            runtime_error = writer_error;
+
+        m_ProcessTimer.stop();
 
         // Run loggers one last time to ensure we have the latest statistics displayed.
         write_to_loggers();
 
+        if(m_SyntheticSource.has_value() && !runtime_error.has_value())
+            runtime_error = write_benchmark_report(start_usage);
+
         return runtime_error;
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoProcessor::process_ranges(
+        const std::function<bool(lvk::Frame&)>& output_callback,
+        const bool profile
+    )
+    {
+        const double framerate = input_framerate();
+
+        // Stateful filters need to see the frames either side of a range to produce its output.
+        // Their delays add up along the chain, so pre- and post-roll by the total delay.
+        size_t filter_delay = 0;
+        std::vector<std::shared_ptr<lvk::StabilizationFilter>> stabilizers;
+        for(const auto& filter : m_Processor.filters())
+        {
+            if(auto stabilizer = std::dynamic_pointer_cast<lvk::StabilizationFilter>(filter))
+            {
+                filter_delay += stabilizer->frame_delay();
+                stabilizers.push_back(stabilizer);
+            }
+        }
+        const auto roll_time = lvk::Time::Timestep(framerate) * static_cast<double>(filter_delay);
+
+        // Validate all the ranges up front, so we fail before any output is written. Inputs
+        // which can't seek are read through only once, so no frame can be rolled into two ranges.
+        const bool seekable = is_input_seekable();
+        lvk::Time previous_end;
+        std::optional<lvk::Time> previous_postroll_end;
+        for(const auto& range : m_Configuration.process_ranges)
+        {
+            const auto start = range.start.to_time(framerate);
+            if(start < previous_end)
+                return "Ranges must be given in order, and must not overlap";
+
+            if(!seekable && previous_postroll_end.has_value() && start < *previous_postroll_end + roll_time)
+            {
+                return cv::format(
+                    "Range starting at %s is too close to the previous range, as the input can\'t seek",
+                    start.hms().c_str()
+                );
+            }
+
+            if(range.end.has_value())
+            {
+                previous_end = range.end->to_time(framerate);
+                previous_postroll_end = previous_end + roll_time;
+                if(previous_end <= start)
+                    return cv::format("Range starting at %s is empty", start.hms().c_str());
+            }
+            else previous_end = lvk::Time::Seconds(std::numeric_limits<double>::max());
+        }
+
+        // The frame which ended a range when reading through the input, kept for the next range.
+        std::optional<lvk::Frame> carried_frame;
+
+        for(const auto& range : m_Configuration.process_ranges)
+        {
+            const auto start = range.start.to_time(framerate);
+            const auto preroll_start = start > roll_time ? start - roll_time : lvk::Time();
+
+            std::optional<lvk::Time> stop_time;
+            if(range.end.has_value())
+                stop_time = range.end->to_time(framerate);
+
+            // Inputs which can't seek are skipped through by reading instead. Each range
+            // is a discontinuity, so the stateful filters must also start over.
+            if(seekable)
+            {
+                if(!seek_input(preroll_start))
+                    return cv::format("Failed to seek the input to %s", preroll_start.hms().c_str());
+                carried_frame.reset();
+            }
+
+            for(auto& stabilizer : stabilizers)
+                stabilizer->restart();
+
+            bool stop_processing = false;
+            m_Processor.stream(
+                [&, this](lvk::Frame& frame){
+                    bool carried = carried_frame.has_value();
+                    if(carried)
+                    {
+                        frame = std::move(*carried_frame);
+                        carried_frame.reset();
+                    }
+
+                    while(carried || read_input(frame))
+                    {
+                        carried = false;
+
+                        const lvk::Time timestamp(frame.timestamp);
+                        if(timestamp < preroll_start)
+                            continue;
+
+                        if(!stop_time.has_value() || timestamp < *stop_time + roll_time)
+                            return true;
+
+                        // The frame is past the post-roll, but may be pre-roll for the next range.
+                        carried_frame = std::move(frame);
+                        return false;
+                    }
+                    return false;
+                },
+                [&, this](lvk::Frame& frame){
+                    // Only output frames within the range, the rest are pre- and post-roll.
+                    const lvk::Time timestamp(frame.timestamp);
+                    if(timestamp < start || (stop_time.has_value() && timestamp >= *stop_time))
+                        return m_Terminate;
+
+                    stop_processing = output_callback(frame);
+                    return stop_processing;
+                },
+                profile
+            );
+
+            if(stop_processing || m_Terminate)
+                break;
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    int VideoProcessor::input_codec() const
+    {
+        // Cached frames keep the codec of the input they were decoded from.
+        if(m_CacheInputStream.is_open())
+            return m_CacheInputStream.codec();
+
+#ifdef FFMPEG_BACKEND
+        return static_cast<int>(m_FFmpegInputStream.codec_id());
+#else
+        if(m_InputStream.isOpened())
+            return static_cast<int>(m_InputStream.get(cv::CAP_PROP_FOURCC));
+
+        if(m_ParallelInputStream.is_open())
+            return m_ParallelInputStream.fourcc();
+
+        return cv::VideoWriter::fourcc('m', 'p', '4', 'v');
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool VideoProcessor::read_input(lvk::Frame& frame)
+    {
+        if(m_CacheInputStream.is_open())
+            return m_CacheInputStream.read(frame);
+
+        if(!m_CacheOutputStream.is_open())
+            return read_source(frame);
+
+        // The cache is only kept once the whole input has been written to it.
+        if(!read_source(frame))
+        {
+            if(m_CacheOutputStream.finish().has_value())
+                m_CacheOutputStream.close();
+            return false;
+        }
+
+        if(!m_CacheOutputStream.write(frame))
+            m_CacheOutputStream.close();
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool VideoProcessor::read_source(lvk::Frame& frame)
+    {
+        if(m_SyntheticSource.has_value())
+            return m_SyntheticSource->read(frame);
+
+        if(m_RawInputStream.is_open())
+            return m_RawInputStream.read(frame);
+
+        if(m_ParallelInputStream.is_open())
+            return m_ParallelInputStream.read(frame);
+
+        if(m_SequenceInputStream.is_open())
+            return m_SequenceInputStream.read(frame);
+
+        if(m_SharedInputStream.is_open())
+            return m_SharedInputStream.read(frame);
+
+        if(m_LosslessInputStream.is_open())
+            return m_LosslessInputStream.read(frame);
+
+#ifdef FFMPEG_BACKEND
+        if(m_FFmpegInputStream.is_open())
+            return m_FFmpegInputStream.read(frame);
+#endif
+
+        if(m_DeviceCapture && m_Configuration.realtime_latency.has_value())
+            return read_realtime_input(frame);
+
+        if(!m_InputStream.read(frame))
+            return false;
+
+        // Assume the input frame is BGR, and set its timestamp if supported.
+        const auto stream_position = std::max(0.0, m_InputStream.get(cv::CAP_PROP_POS_MSEC));
+        frame.format = lvk::VideoFrame::BGR;
+        frame.timestamp = static_cast<uint64_t>(lvk::Time::Milliseconds(stream_position).nanoseconds());
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool VideoProcessor::read_realtime_input(lvk::Frame& frame)
+    {
+        // Frames are grabbed without being decoded, so that any frame which would not meet
+        // its deadline can be dropped before costing anything. While the output is over the
+        // latency target, drop frames until the chain has caught up with its queued frames.
+        size_t dropped_frames = 0;
+        while(m_InputStream.grab())
+        {
+            const auto capture_time = m_ProcessTimer.elapsed();
+
+            const auto& status = m_Processor.stream_status();
+            const size_t queued_frames = status.input_queue_depth + status.output_queue_depth;
+            const auto output_latency = lvk::Time(m_OutputLatency.load());
+
+            if(queued_frames > 0 && output_latency > *m_Configuration.realtime_latency)
+            {
+                dropped_frames++;
+                continue;
+            }
+
+            if(!m_InputStream.retrieve(frame))
+                return false;
+
+            // Timestamp with the capture time, so the chain sees the true spacing across any gap.
+            frame.format = lvk::VideoFrame::BGR;
+            frame.timestamp = static_cast<uint64_t>(capture_time.nanoseconds());
+
+            if(dropped_frames > 0)
+                m_Processor.mark_stream_gap(dropped_frames);
+
+            return true;
+        }
+
+        return false;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool VideoProcessor::seek_input(const lvk::Time& position)
+    {
+        if(m_CacheInputStream.is_open())
+            return m_CacheInputStream.seek(position);
+
+        if(m_SequenceInputStream.is_open())
+            return m_SequenceInputStream.seek(position);
+
+        if(m_LosslessInputStream.is_open())
+            return m_LosslessInputStream.seek(position);
+
+#ifdef FFMPEG_BACKEND
+        if(m_FFmpegInputStream.is_open())
+            return m_FFmpegInputStream.seek(position);
+#endif
+
+        // NOTE: OpenCV's FFmpeg backend seeks to the preceding keyframe and decodes up to the position.
+        if(m_InputStream.isOpened() && !m_DeviceCapture)
+            return m_InputStream.set(cv::CAP_PROP_POS_MSEC, position.milliseconds());
+
+        return false;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool VideoProcessor::is_input_seekable() const
+    {
+        if(m_CacheInputStream.is_open() || m_SequenceInputStream.is_open() || m_LosslessInputStream.is_open())
+            return true;
+
+#ifdef FFMPEG_BACKEND
+        if(m_FFmpegInputStream.is_open())
+            return true;
+#endif
+
+        return m_InputStream.isOpened() && !m_DeviceCapture;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t VideoProcessor::frames_processed() const
+    {
+        return m_FrameTimer.tick_count();
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoProcessor::write_to_loggers()
     {
-        m_ConsoleLogger.clear();
+        if(m_Configuration.print_progress || m_Configuration.print_timings)
+            m_ConsoleLogger.clear();
+
+        if(m_Configuration.print_progress)
+            print_progress();
 
-        print_progress();
         if(m_Configuration.print_timings)
             print_filter_timings();
 
         if(m_DataLogger.has_value())
             log_timing_data();
+
+        if(m_MetricsExporter.is_running())
+            m_MetricsExporter.publish(make_metrics());
+
+        m_FilterMetricsRequested = true;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -250,20 +1038,102 @@ namespace clt
         // NOTE: The frame count is not valid for device capture streams
         double frame_count = m_InputStream.get(cv::CAP_PROP_FRAME_COUNT);
         double frame_number = m_InputStream.get(cv::CAP_PROP_POS_FRAMES);
+        if(m_SyntheticSource.has_value())
+        {
+            frame_count = m_SyntheticSource->settings().frame_count;
+            frame_number = m_SyntheticSource->frames_read();
+        }
+        else if(m_CacheInputStream.is_open())
+        {
+            frame_count = static_cast<double>(m_CacheInputStream.frame_count());
+            frame_number = static_cast<double>(m_CacheInputStream.frames_read());
+        }
+#ifdef FFMPEG_BACKEND
+        else if(m_FFmpegInputStream.is_open())
+        {
+            frame_count = static_cast<double>(m_FFmpegInputStream.frame_count());
+            frame_number = static_cast<double>(m_FFmpegInputStream.frames_read());
+        }
+#endif
+        else if(m_ParallelInputStream.is_open())
+        {
+            frame_count = static_cast<double>(m_ParallelInputStream.frame_count());
+            frame_number = static_cast<double>(m_ParallelInputStream.frames_read());
+        }
+        else if(m_SequenceInputStream.is_open())
+        {
+            frame_count = static_cast<double>(m_SequenceInputStream.frame_count());
+            frame_number = static_cast<double>(m_SequenceInputStream.frames_read());
+        }
+        else if(m_LosslessInputStream.is_open())
+        {
+            frame_count = static_cast<double>(m_LosslessInputStream.frame_count());
+            frame_number = static_cast<double>(m_LosslessInputStream.frames_read());
+        }
+        else if(m_RawInputStream.is_open())
+        {
+            // Piped streams have no known length, so are treated like device captures.
+            frame_count = 0.0;
+            frame_number = static_cast<double>(m_RawInputStream.frames_read());
+        }
+        else if(m_SharedInputStream.is_open())
+        {
+            frame_count = 0.0;
+            frame_number = static_cast<double>(m_SharedInputStream.frames_read());
+        }
+        const bool bounded_stream = !m_DeviceCapture && !m_RawInputStream.is_open() && !m_SharedInputStream.is_open();
 
         // Input Stream Info
         m_ConsoleLogger << "Processing target: ";
-        if(!m_DeviceCapture)
+        if(m_SyntheticSource.has_value())
         {
-            m_ConsoleLogger << std::get<std::filesystem::path>(m_Configuration.input_source).string()
+            const auto& settings = m_SyntheticSource->settings();
+            m_ConsoleLogger << cv::format(
+                                   "Benchmark %dx%d@%.0f",
+                                   settings.resolution.width,
+                                   settings.resolution.height,
+                                   settings.framerate
+                               )
                             << "  " << make_progress_bar(40, frame_number / frame_count)
                             << ConsoleLogger::Next;
         }
+        else if(m_RawInputStream.is_open())
+        {
+            const auto& source = std::get<RawVideoSource>(m_Configuration.input_source);
+            m_ConsoleLogger << (source.path == "-" ? std::string("stdin") : source.path.string())
+                            << cv::format(
+                                   "  (%s %dx%d@%.2f)",
+                                   source.y4m ? "Y4M" : "YUV",
+                                   m_RawInputStream.resolution().width,
+                                   m_RawInputStream.resolution().height,
+                                   m_RawInputStream.framerate()
+                               )
+                            << ConsoleLogger::Next;
+        }
+        else if(m_SharedInputStream.is_open())
+        {
+            const auto& source = std::get<SharedFrameSource>(m_Configuration.input_source);
+            m_ConsoleLogger << "shm:" << source.name
+                            << cv::format(
+                                   "  (%dx%d@%.2f)",
+                                   m_SharedInputStream.resolution().width,
+                                   m_SharedInputStream.resolution().height,
+                                   m_SharedInputStream.framerate()
+                               )
+                            << ConsoleLogger::Next;
+        }
+        else if(!m_DeviceCapture)
+        {
+            // NOTE: The frame count of a video file is often only an estimate.
+            m_ConsoleLogger << std::get<std::filesystem::path>(m_Configuration.input_source).string()
+                            << "  " << make_progress_bar(40, std::clamp(frame_number / std::max(frame_count, 1.0), 0.0, 1.0))
+                            << ConsoleLogger::Next;
+        }
         else m_ConsoleLogger << "Device Capture" << ConsoleLogger::Next;
 
         // Print Elapsed time
         m_ConsoleLogger << "   Elapsed: " << m_ProcessTimer.elapsed().hms();
-        if(!m_DeviceCapture)
+        if(bounded_stream)
         {
             lvk::Time est_remaining_time = lvk::Time::Seconds(
                 std::ceil((frame_count - frame_number) / m_FrameTimer.average().frequency())
@@ -284,12 +1154,28 @@ namespace clt
         m_ConsoleLogger << "   FPS: "
                         << std::fixed << std::setprecision(0) << m_FrameTimer.average().frequency()
                         << ConsoleLogger::Next;
+
+        // Print real-time latency and drops
+        if(m_DeviceCapture && m_Configuration.realtime_latency.has_value())
+        {
+            m_ConsoleLogger << "   Latency: "
+                            << lvk::Time(m_OutputLatency.load()).milliseconds() << "ms"
+                            << " (peak " << lvk::Time(m_PeakLatency.load()).milliseconds() << "ms"
+                            << ", target " << m_Configuration.realtime_latency->milliseconds() << "ms)"
+                            << "   Dropped: " << m_Processor.stream_status().frames_skipped.load()
+                            << ConsoleLogger::Next;
+        }
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoProcessor::print_filter_timings()
     {
+        // Counters are still being written by the filtering thread, so come from the last capture.
+        const auto filter_metrics = this->filter_metrics();
+        const bool has_counters = lvk::PerformanceCounters::IsEnabled()
+                               && filter_metrics.size() == m_Processor.filter_count() + 1;
+
         // Print timing data for each of the filters
         m_ConsoleLogger << std::setprecision(2);
         m_ConsoleLogger << ConsoleLogger::Next << "Filters: " << ConsoleLogger::Next;
@@ -297,16 +1183,52 @@ namespace clt
         {
             auto filter = m_Processor.filters(i);
             auto average_timing = filter->timings().average();
+            auto& allocations = filter->allocations();
 
             m_ConsoleLogger << std::to_string(i) <<  ".   "
                             << filter->alias()
                             << "\t" << average_timing.milliseconds() << "ms"
                             << " +/- " << filter->timings().deviation().milliseconds() << "ms"
                             << "   (" << static_cast<uint64_t>(average_timing.frequency()) << "FPS)"
+                            << "   " << to_megabytes(allocations.current_bytes()) << "MB"
+                            << " (peak " << to_megabytes(allocations.peak_bytes()) << "MB, "
+                            << allocations.allocation_count() << " allocs)"
+                            << ConsoleLogger::Next;
+
+            if(has_counters)
+            {
+                const auto& metrics = filter_metrics[i + 1];
+                print_filter_counters(metrics.counters, "total");
+                for(const auto& [stage, counters] : metrics.stage_counters)
+                    print_filter_counters(counters, stage);
+            }
+        }
+
+        // Print timing data for the encoder
+        if(m_OutputWriter.is_running())
+        {
+            const auto& encoder_timings = m_OutputWriter.timings();
+            m_ConsoleLogger << ConsoleLogger::Next << "Encoder: "
+                            << encoder_timings.average().milliseconds() << "ms"
+                            << " +/- " << encoder_timings.deviation().milliseconds() << "ms"
+                            << "   (queue " << m_OutputWriter.queue_depth()
+                            << "/" << m_OutputWriter.queue_capacity() << ")"
                             << ConsoleLogger::Next;
         }
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoProcessor::print_filter_counters(const lvk::PerformanceCounters& counters, const std::string& label)
+    {
+        m_ConsoleLogger << "      " << label << ":"
+                        << std::setprecision(2) << "  IPC " << counters.instructions_per_cycle()
+                        << std::setprecision(0) << "  LLC misses " << counters.llc_misses_per_sample()
+                        << "  branch misses " << counters.branch_misses_per_sample()
+                        << "  (per frame)"
+                        << std::setprecision(2) << ConsoleLogger::Next;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoProcessor::log_timing_data()
@@ -324,6 +1246,9 @@ namespace clt
             // 3. All filter frametimes
             // 4. Processor deviation
             // 5. All filter deviations
+            // 6. All filter memory usage
+            // 7. All filter peak memory usage
+            // 8. All filter IPC and LLC misses per frame (if counters are enabled)
 
             logger << "Output Frame";
 
@@ -336,6 +1261,22 @@ namespace clt
             for(auto& filter : m_Processor.filters())
                 logger << (filter->alias() + " Deviation (ms)");
 
+            // Then log all the memory usage
+            for(auto& filter : m_Processor.filters())
+                logger << (filter->alias() + " Memory (MB)");
+
+            for(auto& filter : m_Processor.filters())
+                logger << (filter->alias() + " Peak Memory (MB)");
+
+            if(lvk::PerformanceCounters::IsEnabled())
+            {
+                for(auto& filter : m_Processor.filters())
+                    logger << (filter->alias() + " IPC");
+
+                for(auto& filter : m_Processor.filters())
+                    logger << (filter->alias() + " LLC Misses");
+            }
+
             logger.next();
         }
 
@@ -352,9 +1293,355 @@ namespace clt
         for(auto& filter : m_Processor.filters())
             logger << filter->timings().deviation().milliseconds();
 
+        // write all memory usage
+        for(auto& filter : m_Processor.filters())
+            logger << to_megabytes(filter->allocations().current_bytes());
+
+        for(auto& filter : m_Processor.filters())
+            logger << to_megabytes(filter->allocations().peak_bytes());
+
+        // write all counter data, from the last capture on the filtering thread
+        if(lvk::PerformanceCounters::IsEnabled())
+        {
+            const auto filter_metrics = this->filter_metrics();
+            const bool has_counters = filter_metrics.size() == m_Processor.filter_count() + 1;
+
+            for(size_t i = 0; i < m_Processor.filter_count(); i++)
+                logger << (has_counters ? filter_metrics[i + 1].counters.instructions_per_cycle() : 0.0);
+
+            for(size_t i = 0; i < m_Processor.filter_count(); i++)
+                logger << (has_counters ? filter_metrics[i + 1].counters.llc_misses_per_sample() : 0.0);
+        }
+
         logger.next();
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<double> sorted_samples(const lvk::Stopwatch& timer)
+    {
+        std::vector<double> samples;
+        samples.reserve(timer.history().size());
+        for(const auto& sample : timer.history())
+            samples.push_back(sample.milliseconds());
+        std::sort(samples.begin(), samples.end());
+
+        return samples;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double percentile(const std::vector<double>& sorted_samples, const double p)
+    {
+        if(sorted_samples.empty())
+            return 0.0;
+
+        return sorted_samples[static_cast<size_t>(std::round(p * static_cast<double>(sorted_samples.size() - 1)))];
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void write_latency_statistics(cv::FileStorage& file, const lvk::Stopwatch& timer)
+    {
+        const auto samples = sorted_samples(timer);
+
+        file << "samples" << static_cast<int>(samples.size())
+             << "mean_ms" << timer.average().milliseconds()
+             << "deviation_ms" << timer.deviation().milliseconds()
+             << "p50_ms" << percentile(samples, 0.50)
+             << "p90_ms" << percentile(samples, 0.90)
+             << "p95_ms" << percentile(samples, 0.95)
+             << "p99_ms" << percentile(samples, 0.99)
+             << "max_ms" << percentile(samples, 1.00);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::string metric_label(const std::string& value)
+    {
+        // Escape the label value as per the Prometheus text format.
+        std::string label;
+        for(const char c : value)
+        {
+            if(c == '\\' || c == '"') label.push_back('\\');
+            if(c == '\n') label += "\\n";
+            else label.push_back(c);
+        }
+        return label;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::string VideoProcessor::make_metrics() const
+    {
+        std::ostringstream metrics;
+        metrics << std::setprecision(9);
+
+        const auto declare = [&](const char* name, const char* type, const char* help){
+            metrics << "# HELP " << name << " " << help << "\n"
+                    << "# TYPE " << name << " " << type << "\n";
+        };
+
+        const auto& status = m_Processor.stream_status();
+
+        declare("lvk_frames_read_total", "counter", "Frames read from the input.");
+        metrics << "lvk_frames_read_total " << status.frames_read << "\n";
+
+        declare("lvk_frames_filtered_total", "counter", "Frames output by the filter chain.");
+        metrics << "lvk_frames_filtered_total " << status.frames_filtered << "\n";
+
+        declare("lvk_frames_dropped_total", "counter", "Frames for which the filter chain produced no output.");
+        metrics << "lvk_frames_dropped_total " << status.frames_dropped << "\n";
+
+        declare("lvk_frames_skipped_total", "counter", "Frames dropped on capture to meet the real-time latency target.");
+        metrics << "lvk_frames_skipped_total " << status.frames_skipped << "\n";
+
+        declare("lvk_capture_latency_seconds", "gauge", "Capture to output latency of the last real-time frame.");
+        metrics << "lvk_capture_latency_seconds " << lvk::Time(m_OutputLatency.load()).seconds() << "\n";
+
+        declare("lvk_frames_written_total", "counter", "Frames delivered to the output.");
+        metrics << "lvk_frames_written_total " << m_FrameTimer.tick_count() << "\n";
+
+        declare("lvk_queue_depth", "gauge", "Number of frames waiting in each stream queue.");
+        metrics << "lvk_queue_depth{queue=\"input\"} " << status.input_queue_depth << "\n"
+                << "lvk_queue_depth{queue=\"output\"} " << status.output_queue_depth << "\n";
+
+        declare("lvk_encoder_queue_depth", "gauge", "Number of frames waiting to be encoded.");
+        metrics << "lvk_encoder_queue_depth " << m_OutputWriter.queue_depth() << "\n";
+
+        declare("lvk_output_fps", "gauge", "Average output framerate.");
+        metrics << "lvk_output_fps " << m_FrameTimer.average().frequency() << "\n";
+
+        declare("lvk_elapsed_seconds", "gauge", "Time since processing started.");
+        metrics << "lvk_elapsed_seconds " << m_ProcessTimer.elapsed().seconds() << "\n";
+
+        // Filter state comes from the last capture on the filtering thread.
+        auto filter_metrics = this->filter_metrics();
+
+        declare("lvk_filter_latency_seconds", "summary", "Filter processing latency, with quantiles over recent frames.");
+        for(auto& filter : filter_metrics)
+        {
+            const auto label = metric_label(filter.alias);
+            auto& samples = filter.latency_samples;
+            std::sort(samples.begin(), samples.end());
+
+            for(const double q : {0.5, 0.9, 0.99})
+            {
+                metrics << "lvk_filter_latency_seconds{filter=\"" << label << "\",quantile=\"" << q << "\"} "
+                        << percentile(samples, q) / 1000.0 << "\n";
+            }
+
+            metrics << "lvk_filter_latency_seconds_sum{filter=\"" << label << "\"} " << filter.latency_total / 1000.0 << "\n"
+                    << "lvk_filter_latency_seconds_count{filter=\"" << label << "\"} " << filter.latency_count << "\n";
+        }
+
+        declare("lvk_filter_memory_bytes", "gauge", "Host memory currently allocated by each filter.");
+        for(const auto& filter : m_Processor.filters())
+        {
+            metrics << "lvk_filter_memory_bytes{filter=\"" << metric_label(filter->alias()) << "\"} "
+                    << filter->allocations().current_bytes() << "\n";
+        }
+
+        declare("lvk_filter_peak_memory_bytes", "gauge", "Peak host memory allocated by each filter.");
+        for(const auto& filter : m_Processor.filters())
+        {
+            metrics << "lvk_filter_peak_memory_bytes{filter=\"" << metric_label(filter->alias()) << "\"} "
+                    << filter->allocations().peak_bytes() << "\n";
+        }
+
+        declare("lvk_tracking_stability", "gauge", "Tracking stability of each stabilization filter.");
+        for(const auto& filter : filter_metrics)
+        {
+            if(filter.tracking_stability.has_value())
+            {
+                metrics << "lvk_tracking_stability{filter=\"" << metric_label(filter.alias) << "\"} "
+                        << *filter.tracking_stability << "\n";
+            }
+        }
+
+        declare("lvk_scene_quality", "gauge", "Smoothed scene quality of each stabilization filter.");
+        for(const auto& filter : filter_metrics)
+        {
+            if(filter.scene_quality.has_value())
+            {
+                metrics << "lvk_scene_quality{filter=\"" << metric_label(filter.alias) << "\"} "
+                        << *filter.scene_quality << "\n";
+            }
+        }
+
+        declare("lvk_process_peak_memory_bytes", "gauge", "Peak resident memory of the process.");
+        metrics << "lvk_process_peak_memory_bytes " << ResourceUsage::Query().peak_memory << "\n";
+
+        return metrics.str();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoProcessor::publish_filter_metrics()
+    {
+        const auto& filters = m_Processor.filters();
+
+        // The summary totals must cover every frame, not just the recent timing history.
+        m_LatencyTotals.resize(filters.size() + 1);
+        for(size_t i = 0; i <= filters.size(); i++)
+        {
+            const auto& history = (i == 0 ? m_Processor.timings() : filters[i - 1]->timings()).history();
+            if(!history.is_empty())
+            {
+                m_LatencyTotals[i].first += history.newest().milliseconds();
+                m_LatencyTotals[i].second++;
+            }
+        }
+
+        // Only capture once the metrics have been published, as copying the timing histories
+        // on every frame would add needless work to the filtering thread.
+        if(!m_FilterMetricsRequested.exchange(false))
+            return;
+
+        const auto capture = [this](const size_t index, const std::string& alias, const lvk::VideoFilter& filter){
+            FilterMetrics metrics;
+            metrics.alias = alias;
+            metrics.latency_samples.reserve(filter.timings().history().size());
+            for(const auto& sample : filter.timings().history())
+                metrics.latency_samples.push_back(sample.milliseconds());
+            metrics.latency_total = m_LatencyTotals[index].first;
+            metrics.latency_count = m_LatencyTotals[index].second;
+            if(lvk::PerformanceCounters::IsEnabled())
+            {
+                metrics.counters = filter.counters();
+                metrics.stage_counters = filter.stage_counters();
+            }
+            return metrics;
+        };
+
+        std::vector<FilterMetrics> filter_metrics;
+        filter_metrics.push_back(capture(0, "Processor", m_Processor));
+        for(size_t i = 0; i < filters.size(); i++)
+        {
+            const auto& filter = filters[i];
+            auto& metrics = filter_metrics.emplace_back(capture(i + 1, filter->alias(), *filter));
+            if(const auto stabilizer = std::dynamic_pointer_cast<lvk::StabilizationFilter>(filter))
+            {
+                metrics.tracking_stability = stabilizer->tracking_stability();
+                metrics.scene_quality = stabilizer->scene_quality();
+            }
+        }
+
+        std::scoped_lock lock(m_FilterMetricsMutex);
+        m_FilterMetrics = std::move(filter_metrics);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<VideoProcessor::FilterMetrics> VideoProcessor::filter_metrics() const
+    {
+        std::scoped_lock lock(m_FilterMetricsMutex);
+        return m_FilterMetrics;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void write_counter_statistics(cv::FileStorage& file, const lvk::PerformanceCounters& counters)
+    {
+        const auto& total = counters.total();
+        file << "samples" << static_cast<int>(counters.sample_count())
+             << "cycles" << static_cast<double>(total.cycles)
+             << "instructions" << static_cast<double>(total.instructions)
+             << "llc_misses" << static_cast<double>(total.llc_misses)
+             << "branch_misses" << static_cast<double>(total.branch_misses)
+             << "ipc" << counters.instructions_per_cycle();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoProcessor::write_benchmark_report(const ResourceUsage& start_usage)
+    {
+        LVK_ASSERT(m_SyntheticSource.has_value());
+
+        const auto end_usage = ResourceUsage::Query();
+        const auto& settings = m_SyntheticSource->settings();
+
+        const double wall_time = m_ProcessTimer.elapsed().seconds();
+        const double cpu_time = (end_usage.cpu_time - start_usage.cpu_time).seconds();
+        const double throughput = static_cast<double>(m_FrameTimer.tick_count()) / std::max(wall_time, 1e-9);
+
+        // Write to memory so that the report can also be printed to the console.
+        const bool write_to_file = m_Configuration.benchmark_report.has_value();
+        cv::FileStorage file(
+            write_to_file ? m_Configuration.benchmark_report->string() : ".json",
+            cv::FileStorage::WRITE | cv::FileStorage::FORMAT_JSON | (write_to_file ? 0 : cv::FileStorage::MEMORY)
+        );
+        if(!file.isOpened())
+        {
+            return cv::format(
+                "Failed to open benchmark report \'%s\'",
+                m_Configuration.benchmark_report->string().c_str()
+            );
+        }
+
+        file << "resolution" << settings.resolution
+             << "framerate" << settings.framerate
+             << "frames" << static_cast<int>(m_FrameTimer.tick_count())
+             << "opencl" << static_cast<int>(cv::ocl::useOpenCL())
+             << "threads" << cv::getNumThreads();
+
+        file << "wall_time_s" << wall_time
+             << "throughput_fps" << throughput
+             << "realtime_factor" << throughput / settings.framerate;
+
+        // CPU utilisation is relative to a single core, so can exceed 100%.
+        file << "cpu_time_s" << cpu_time
+             << "cpu_utilisation" << cpu_time / std::max(wall_time, 1e-9)
+             << "hardware_threads" << static_cast<int>(std::thread::hardware_concurrency())
+             << "peak_memory_mb" << to_megabytes(end_usage.peak_memory);
+
+        // Startup covers everything before processing began, including loading shared libraries.
+        file << "startup_time_s" << start_usage.uptime.seconds()
+             << "startup_peak_memory_mb" << to_megabytes(start_usage.peak_memory);
+
+        file << "frame_interval" << "{";
+        write_latency_statistics(file, m_FrameTimer);
+        file << "}";
+
+        file << "stages" << "[";
+        file << "{" << "name" << "Processor";
+        write_latency_statistics(file, m_Processor.timings());
+        file << "}";
+        for(const auto& filter : m_Processor.filters())
+        {
+            file << "{" << "name" << filter->alias();
+            write_latency_statistics(file, filter->timings());
+            file << "memory_mb" << to_megabytes(filter->allocations().current_bytes())
+                 << "peak_memory_mb" << to_megabytes(filter->allocations().peak_bytes())
+                 << "allocations" << static_cast<int>(filter->allocations().allocation_count());
+
+            if(lvk::PerformanceCounters::IsEnabled())
+            {
+                file << "counters" << "{";
+                write_counter_statistics(file, filter->counters());
+                file << "}";
+
+                file << "stage_counters" << "[";
+                for(const auto& [stage, counters] : filter->stage_counters())
+                {
+                    file << "{" << "name" << stage;
+                    write_counter_statistics(file, counters);
+                    file << "}";
+                }
+                file << "]";
+            }
+            file << "}";
+        }
+        file << "]";
+
+        if(write_to_file)
+            file.release();
+        else
+            std::cout << "\n" << file.releaseAndGetString() << "\n";
+
+        return std::nullopt;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     std::string VideoProcessor::make_progress_bar(const uint32_t length, const double progress)
@@ -19,9 +19,28 @@
 
 #include <LiveVisionKit.hpp>
 #include <fstream>
+#include <atomic>
+#include <mutex>
 
 #include "VideoIOConfiguration.hpp"
+#include "SyntheticSource.hpp"
+#include "RawVideoIO.hpp"
+#include "ParallelDecoder.hpp"
+#include "ImageSequenceIO.hpp"
+#include "SharedFrameIO.hpp"
+#include "FrameCache.hpp"
+#include "LosslessVideoIO.hpp"
+#include "Checkpoint.hpp"
+#ifdef FFMPEG_BACKEND
+#include "FFmpegVideoIO.hpp"
+#endif
+#include "ResourceUsage.hpp"
+#include "MetricsExporter.hpp"
+#include "AsyncFrameWriter.hpp"
 #include "ConsoleLogger.hpp"
+#ifdef PREVIEW_WINDOW
+#include "PreviewWindow.hpp"
+#endif
 
 namespace clt
 {
@@ -36,20 +55,59 @@ namespace clt
 
         void stop();
 
+        uint64_t frames_processed() const;
+
     private:
 
         std::optional<std::string> initialize_configuration();
 
         std::optional<std::string> initialize_output_stream(const cv::Size frame_size);
 
+        std::optional<std::string> close_output_stream();
+
+        std::optional<std::string> initialize_checkpoint();
+
+        std::optional<std::string> save_checkpoint(const lvk::Time& segment_end);
+
+        std::filesystem::path output_path() const;
+
+        double input_framerate() const;
+
+        int input_codec() const;
+
+        bool read_input(lvk::Frame& frame);
+
+        bool read_source(lvk::Frame& frame);
+
+        bool read_realtime_input(lvk::Frame& frame);
+
+        bool seek_input(const lvk::Time& position);
+
+        bool is_input_seekable() const;
+
+        std::optional<std::string> process_ranges(
+            const std::function<bool(lvk::Frame&)>& output_callback,
+            const bool profile
+        );
+
         void write_to_loggers();
 
         void print_progress();
 
         void print_filter_timings();
 
+        void print_filter_counters(const lvk::PerformanceCounters& counters, const std::string& label);
+
         void log_timing_data();
 
+        std::string make_metrics() const;
+
+        void publish_filter_metrics();
+
+        std::vector<FilterMetrics> filter_metrics() const;
+
+        std::optional<std::string> write_benchmark_report(const ResourceUsage& start_usage);
+
         static std::string make_progress_bar(const uint32_t length, const double progress);
 
     private:
@@ -59,11 +117,54 @@ namespace clt
         std::ofstream m_DataLogStream;
         std::optional<lvk::CSVLogger> m_DataLogger;
         ConsoleLogger m_ConsoleLogger;
+        MetricsExporter m_MetricsExporter;
 
         cv::VideoCapture m_InputStream;
+        std::optional<SyntheticSource> m_SyntheticSource;
+        RawVideoReader m_RawInputStream;
+        ParallelDecoder m_ParallelInputStream;
+        ImageSequenceReader m_SequenceInputStream;
+        SharedFrameReader m_SharedInputStream;
+        FrameCacheReader m_CacheInputStream;
+        LosslessVideoReader m_LosslessInputStream;
+        FrameCacheWriter m_CacheOutputStream;
         cv::VideoWriter m_OutputStream;
+        RawVideoWriter m_RawOutputStream;
+        ImageSequenceWriter m_SequenceOutputStream;
+        SharedFrameWriter m_SharedOutputStream;
+        LosslessVideoWriter m_LosslessOutputStream;
+#ifdef FFMPEG_BACKEND
+        FFmpegReader m_FFmpegInputStream;
+        FFmpegWriter m_FFmpegOutputStream;
+#endif
+        AsyncFrameWriter m_OutputWriter;
+#ifdef PREVIEW_WINDOW
+        PreviewWindow m_Preview;
+#endif
         lvk::CompositeFilter m_Processor;
 
+        std::optional<Checkpoint> m_Checkpoint;
+        lvk::Time m_SegmentStart;
+        uint64_t m_LastOutputTimestamp = 0;
+
+        std::atomic<uint64_t> m_OutputLatency = 0, m_PeakLatency = 0;
+
+        // Filter state for the metrics and loggers, captured on the filtering thread on request.
+        struct FilterMetrics
+        {
+            std::string alias;
+            std::vector<double> latency_samples;
+            double latency_total = 0.0;
+            uint64_t latency_count = 0;
+            std::optional<float> tracking_stability, scene_quality;
+            lvk::PerformanceCounters counters;
+            std::vector<std::pair<std::string, lvk::PerformanceCounters>> stage_counters;
+        };
+        mutable std::mutex m_FilterMetricsMutex;
+        std::vector<FilterMetrics> m_FilterMetrics;
+        std::vector<std::pair<double, uint64_t>> m_LatencyTotals; // Only used on the filtering thread
+        std::atomic<bool> m_FilterMetricsRequested = false;
+
         bool m_Terminate = false;
         lvk::TickTimer m_FrameTimer;
         lvk::Stopwatch m_ProcessTimer;